@@ -0,0 +1,72 @@
+#include "array.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+#include <fmt/core.h>
+
+/**
+ * Compares `for_each`, `reduce` and `map` with the equivalent hand-written
+ * loops over the same data. If the lambdas are inlined and the loops
+ * vectorized, each pair runs at the same speed.
+ *
+ * Usage: functional [count] [repeat]   (default 10000000 and 20)
+ */
+
+using clock_type = std::chrono::steady_clock;
+
+template <typename F>
+void measure(std::string_view name, std::size_t count, std::size_t repeat, F&& run) {
+  std::int64_t best = INT64_MAX;
+  std::int64_t checksum = 0;
+  for (std::size_t r = 0; r < repeat; ++r) {
+    auto start = clock_type::now();
+    checksum += run();
+    auto stop = clock_type::now();
+    best = std::min<std::int64_t>(best, std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+  }
+  fmt::print("{:<20} {:>10} ns  {:>6.3f} ns/element  (checksum {})\n", name, best, static_cast<double>(best) / count, checksum);
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  std::size_t repeat = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+  if (count == 0 || repeat == 0) return 0;
+  stdlib::array<int> arr(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    arr[i] = static_cast<int>(i % 1000);
+  }
+  const int* data = arr.begin();
+  fmt::print("{} elements, best of {} runs\n", count, repeat);
+#if !defined(__OPTIMIZE__) && !defined(_MSC_VER)
+  fmt::print("warning: built without optimizations; configure with -DCMAKE_BUILD_TYPE=Release\n");
+#endif
+
+  measure("loop sum", count, repeat, [&] {
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      sum += data[i];
+    }
+    return sum;
+  });
+  measure("reduce sum", count, repeat, [&] { return arr.reduce([](std::int64_t acc, int x) { return acc + x; }, std::int64_t { 0 }); });
+  measure("for_each sum", count, repeat, [&] {
+    std::int64_t sum = 0;
+    arr.for_each([&](int x) { sum += x; });
+    return sum;
+  });
+  measure("loop map", count, repeat, [&] {
+    stdlib::array<int> result(count);
+    int* out = result.begin();
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = data[i] * 3 + 1;
+    }
+    return static_cast<std::int64_t>(out[count - 1]);
+  });
+  measure("map", count, repeat, [&] {
+    auto result = arr.map([](int x) { return x * 3 + 1; });
+    return static_cast<std::int64_t>(result[count - 1]);
+  });
+  return 0;
+}
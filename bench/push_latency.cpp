@@ -0,0 +1,48 @@
+#include "array.hpp"
+#include "incremental_array.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+#include <fmt/core.h>
+
+/**
+ * Measures the latency of every push into an empty container and reports
+ * percentiles, comparing the doubling growth of `array` with the incremental
+ * growth of `incremental_array`.
+ *
+ * Usage: push_latency [count]   (default 10000000)
+ */
+
+using clock_type = std::chrono::steady_clock;
+
+template <typename Array>
+void measure(std::string_view name, std::size_t count) {
+  std::vector<std::int64_t> latencies(count);
+  Array arr;
+  for (std::size_t i = 0; i < count; ++i) {
+    auto start = clock_type::now();
+    arr.push(static_cast<int>(i));
+    auto stop = clock_type::now();
+    latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+  }
+  std::ranges::sort(latencies);
+  auto percentile = [&](double p) { return latencies[static_cast<std::size_t>(p * (count - 1))]; };
+  fmt::print("{:<24} p50 {:>6} ns  p99 {:>6} ns  p99.9 {:>8} ns  max {:>10} ns\n", name, percentile(0.5), percentile(0.99),
+    percentile(0.999), latencies.back());
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  if (count == 0) return 0;
+  fmt::print("push latency over {} pushes\n", count);
+#if !defined(__OPTIMIZE__) && !defined(_MSC_VER)
+  fmt::print("warning: built without optimizations; configure with -DCMAKE_BUILD_TYPE=Release\n");
+#endif
+  measure<stdlib::array<int>>("array<int>", count);
+  measure<stdlib::incremental_array<int>>("incremental_array<int>", count);
+  return 0;
+}
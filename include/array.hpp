@@ -1,9 +1,15 @@
 #ifndef STD_LIB_ARRAY_H
 #define STD_LIB_ARRAY_H
 
+#include "hash_map.hpp"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <charconv>
+#include <cstdint>
 #include <concepts>
+#include <exception>
 #include <functional>
 #include <iostream>
 #include <iterator>
@@ -13,12 +19,544 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include <fmt/core.h>
 #include <fmt/format.h>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 
 namespace stdlib {
 
+/**
+ * @brief Tag type selecting the multi-threaded overload of an operation.
+ *
+ * Pass `stdlib::parallel` as the first argument of an operation to run it on
+ * several threads, or `parallel_t { n }` to choose the number of threads.
+ */
+struct parallel_t {
+  /// @brief The number of threads to use (0 means one per hardware thread).
+  std::size_t threads = 0;
+};
+
+/// @brief Selects the multi-threaded overload of an operation.
+inline constexpr parallel_t parallel {};
+
+namespace detail {
+
+/**
+ * @brief Determines how many threads to use for a parallel operation.
+ *
+ * @param policy The parallel policy.
+ * @param work The amount of work (elements or bytes).
+ * @param grain The minimum amount of work worth a thread of its own.
+ * @return The number of threads, at least one.
+ */
+inline std::size_t thread_count(const parallel_t& policy, std::size_t work, std::size_t grain) {
+  std::size_t threads = policy.threads;
+  if (threads == 0) {
+    threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+  return std::clamp<std::size_t>(work / std::max<std::size_t>(grain, 1), 1, threads);
+}
+
+/**
+ * @brief Runs `f(chunk)` for every chunk in `[0, chunks)`, one thread per chunk.
+ *
+ * The calling thread runs the first chunk. If any invocation throws, the first
+ * exception (by chunk order) is rethrown after all threads have joined.
+ *
+ * @param chunks The number of chunks.
+ * @param f The function to run for each chunk.
+ */
+template <typename F>
+void parallel_for(std::size_t chunks, F&& f) {
+  if (chunks <= 1) {
+    if (chunks == 1) f(std::size_t { 0 });
+    return;
+  }
+  std::vector<std::exception_ptr> errors(chunks);
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(chunks - 1);
+    for (std::size_t chunk = 1; chunk < chunks; ++chunk) {
+      workers.emplace_back([&f, &errors, chunk] {
+        try {
+          f(chunk);
+        } catch (...) {
+          errors[chunk] = std::current_exception();
+        }
+      });
+    }
+    try {
+      f(std::size_t { 0 });
+    } catch (...) {
+      errors[0] = std::current_exception();
+    }
+  }
+  for (auto& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+/// @brief Positions `[0, n)` grouped by the top bits of their hashes.
+struct hash_partitions {
+  /// @brief The hash of every position.
+  std::vector<std::uint64_t> hashes;
+  /// @brief The positions, ascending within each partition.
+  std::vector<std::size_t> order;
+  /// @brief Partition `p` is `order[bounds[p], bounds[p + 1])`.
+  std::vector<std::size_t> bounds;
+};
+
+/**
+ * @brief Hashes positions `[0, n)` and radix-partitions them by hash on `threads` threads.
+ *
+ * Each thread hashes a block and counts its positions per partition, then
+ * scatters them to the offsets given by the counts, so each partition lists
+ * its positions in ascending order and equal hashes share a partition.
+ *
+ * @param n The number of positions.
+ * @param threads The number of threads.
+ * @param hash_of Returns the hash of a position.
+ */
+template <typename HashFn>
+hash_partitions partition_by_hash(std::size_t n, std::size_t threads, HashFn&& hash_of) {
+  std::size_t partitions = std::bit_ceil(threads) * 4;
+  int shift = 64 - std::countr_zero(partitions);
+  hash_partitions result { std::vector<std::uint64_t>(n), std::vector<std::size_t>(n), std::vector<std::size_t>(partitions + 1) };
+  auto blocks = [&](std::size_t t) { return std::pair { t * n / threads, (t + 1) * n / threads }; };
+
+  // counts[t * partitions + p] counts the positions of block t in partition p, then becomes their write offset.
+  std::vector<std::size_t> counts(threads * partitions, 0);
+  parallel_for(threads, [&](std::size_t t) {
+    auto [first, last] = blocks(t);
+    std::size_t* count = counts.data() + t * partitions;
+    for (std::size_t i = first; i < last; ++i) {
+      result.hashes[i] = hash_of(i);
+      ++count[result.hashes[i] >> shift];
+    }
+  });
+  std::size_t offset = 0;
+  for (std::size_t p = 0; p < partitions; ++p) {
+    result.bounds[p] = offset;
+    for (std::size_t t = 0; t < threads; ++t) {
+      offset += std::exchange(counts[t * partitions + p], offset);
+    }
+  }
+  result.bounds[partitions] = n;
+
+  parallel_for(threads, [&](std::size_t t) {
+    auto [first, last] = blocks(t);
+    std::size_t* next = counts.data() + t * partitions;
+    for (std::size_t i = first; i < last; ++i) {
+      result.order[next[result.hashes[i] >> shift]++] = i;
+    }
+  });
+  return result;
+}
+
+/// @brief The type of key returned by `KeyFn` for elements of type `T`.
+template <typename KeyFn, typename T>
+using key_result_t = std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>;
+
+/// @brief The accumulator type of `reduce`: `U` if given, otherwise what `f(initial, value[, index])` returns.
+template <typename U, typename F, typename I, typename T>
+struct reduce_result {
+  using type = U;
+};
+template <typename F, typename I, typename T>
+  requires std::invocable<F&, I, const T&>
+struct reduce_result<void, F, I, T> {
+  using type = std::decay_t<std::invoke_result_t<F&, I, const T&>>;
+};
+template <typename F, typename I, typename T>
+  requires(!std::invocable<F&, I, const T&>) && std::invocable<F&, I, const T&, std::size_t>
+struct reduce_result<void, F, I, T> {
+  using type = std::decay_t<std::invoke_result_t<F&, I, const T&, std::size_t>>;
+};
+/// @brief The accumulator type of `reduce` for elements of type `T` and an initial value of type `I`.
+template <typename U, typename F, typename I, typename T>
+using reduce_result_t = typename reduce_result<U, F, I, T>::type;
+
+/// @brief Removes leading and trailing whitespace.
+inline std::string_view trim(std::string_view text) {
+  constexpr std::string_view whitespace = " \t\r\n\f\v";
+  auto first = text.find_first_not_of(whitespace);
+  if (first == std::string_view::npos) return {};
+  auto last = text.find_last_not_of(whitespace);
+  return text.substr(first, last - first + 1);
+}
+
+/// @brief Counts the non-overlapping occurrences of `sep` in `text`.
+inline std::size_t count_separators(std::string_view text, std::string_view sep) {
+  if (sep.size() == 1) {
+    return static_cast<std::size_t>(std::count(text.begin(), text.end(), sep.front()));
+  }
+  std::size_t count = 0;
+  for (auto pos = text.find(sep); pos != std::string_view::npos; pos = text.find(sep, pos + sep.size())) {
+    ++count;
+  }
+  return count;
+}
+
+/**
+ * @brief Parses a single number, ignoring surrounding whitespace.
+ *
+ * @throws std::invalid_argument If the token is not a number of type `T`.
+ */
+template <typename T>
+T parse_number(std::string_view token) {
+  token = trim(token);
+  // from_chars rejects a leading '+'; drop it only when a digit (or a decimal point) follows, so "+-3" stays invalid.
+  if (token.size() > 1 && token.front() == '+') {
+    char next = token[1];
+    if ((next >= '0' && next <= '9') || (std::is_floating_point_v<T> && next == '.')) token.remove_prefix(1);
+  }
+  T value {};
+  auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+  if (ec != std::errc {} || ptr != token.data() + token.size()) {
+    throw std::invalid_argument(fmt::format("Cannot parse \"{}\" as a number", token));
+  }
+  return value;
+}
+
+/**
+ * @brief Parses every `sep`-separated token of `text` into `out`.
+ *
+ * @return Pointer past the last written value.
+ */
+template <typename T>
+T* parse_numbers(std::string_view text, std::string_view sep, T* out) {
+  for (;;) {
+    auto pos = text.find(sep);
+    *out++ = parse_number<T>(text.substr(0, pos));
+    if (pos == std::string_view::npos) return out;
+    text.remove_prefix(pos + sep.size());
+  }
+}
+
+/// @brief Whether `T` is one of the string types that `join` quotes.
+template <typename T>
+inline constexpr bool is_string = std::is_same_v<std::remove_cvref_t<T>, const char*> || std::is_same_v<std::remove_cvref_t<T>, char*> || std::is_same_v<std::remove_cvref_t<T>, std::string>;
+
+/// @brief Formats an element for `join`, quoting strings.
+template <typename T>
+std::string format_element(const T& value) {
+  if constexpr (is_string<T>) {
+    return fmt::format("\"{}\"", value);
+  } else {
+    return fmt::format("{}", value);
+  }
+}
+
+/// @brief The comparison performed by a `comparison` predicate.
+enum class compare_op { less, less_equal, greater, greater_equal, equal, not_equal };
+
+/// @brief Applies the comparison `Op` to `value` and `operand`.
+template <compare_op Op, typename T, typename U>
+constexpr bool compare(const T& value, const U& operand) {
+  if constexpr (Op == compare_op::less) {
+    return value < operand;
+  } else if constexpr (Op == compare_op::less_equal) {
+    return value <= operand;
+  } else if constexpr (Op == compare_op::greater) {
+    return value > operand;
+  } else if constexpr (Op == compare_op::greater_equal) {
+    return value >= operand;
+  } else if constexpr (Op == compare_op::equal) {
+    return value == operand;
+  } else {
+    return value != operand;
+  }
+}
+
+/**
+ * @brief Copies the elements of `in` for which `pred` holds to `out`.
+ *
+ * Trivially copyable elements are written unconditionally and the output
+ * position only advances when the predicate holds, which avoids a
+ * data-dependent branch. `out` must have room for `n` elements and may alias
+ * `in` as long as it does not start after it.
+ *
+ * @return The number of elements written.
+ */
+template <typename T, typename Pred>
+constexpr std::size_t compress(const T* in, std::size_t n, T* out, Pred& pred) {
+  std::size_t k = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      out[k] = in[i];
+      k += static_cast<bool>(std::invoke(pred, in[i]));
+    } else if (std::invoke(pred, in[i])) {
+      out[k++] = in[i];
+    }
+  }
+  return k;
+}
+
+/// @brief Like `compress`, passing the index of each element to `pred` as well.
+template <typename T, typename Pred>
+constexpr std::size_t compress_indexed(const T* in, std::size_t n, T* out, Pred& pred) {
+  std::size_t k = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      out[k] = in[i];
+      k += static_cast<bool>(std::invoke(pred, in[i], i));
+    } else if (std::invoke(pred, in[i], i)) {
+      out[k++] = in[i];
+    }
+  }
+  return k;
+}
+
+/// @brief Whether `compress_compare` has a vectorized implementation for `T`.
+template <typename T>
+inline constexpr bool has_simd_compress =
+#if defined(__AVX2__) || defined(__AVX512F__)
+  std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && (sizeof(T) == 4 || sizeof(T) == 8);
+#else
+  false;
+#endif
+
+#if defined(__AVX512F__)
+
+template <compare_op Op>
+constexpr int avx512_int_predicate() {
+  constexpr int predicates[] = { _MM_CMPINT_LT, _MM_CMPINT_LE, _MM_CMPINT_NLE, _MM_CMPINT_NLT, _MM_CMPINT_EQ, _MM_CMPINT_NE };
+  return predicates[static_cast<int>(Op)];
+}
+
+template <compare_op Op>
+constexpr int avx512_float_predicate() {
+  constexpr int predicates[] = { _CMP_LT_OQ, _CMP_LE_OQ, _CMP_GT_OQ, _CMP_GE_OQ, _CMP_EQ_OQ, _CMP_NEQ_UQ };
+  return predicates[static_cast<int>(Op)];
+}
+
+/**
+ * @brief Vectorized `compress` for the predicate `value Op operand` (AVX-512).
+ *
+ * Each 512-bit block is compared into a lane mask and written with a
+ * compress-store.
+ */
+template <compare_op Op, typename T>
+std::size_t compress_compare(const T* in, std::size_t n, T* out, T operand) {
+  std::size_t i = 0;
+  std::size_t k = 0;
+  if constexpr (std::is_same_v<T, float>) {
+    const __m512 rhs = _mm512_set1_ps(operand);
+    for (; i + 16 <= n; i += 16) {
+      __m512 v = _mm512_loadu_ps(in + i);
+      __mmask16 m = _mm512_cmp_ps_mask(v, rhs, avx512_float_predicate<Op>());
+      _mm512_mask_compressstoreu_ps(out + k, m, v);
+      k += std::popcount(static_cast<unsigned>(m));
+    }
+  } else if constexpr (std::is_same_v<T, double>) {
+    const __m512d rhs = _mm512_set1_pd(operand);
+    for (; i + 8 <= n; i += 8) {
+      __m512d v = _mm512_loadu_pd(in + i);
+      __mmask8 m = _mm512_cmp_pd_mask(v, rhs, avx512_float_predicate<Op>());
+      _mm512_mask_compressstoreu_pd(out + k, m, v);
+      k += std::popcount(static_cast<unsigned>(m));
+    }
+  } else if constexpr (sizeof(T) == 4) {
+    const __m512i rhs = _mm512_set1_epi32(static_cast<int>(operand));
+    for (; i + 16 <= n; i += 16) {
+      __m512i v = _mm512_loadu_si512(in + i);
+      __mmask16 m;
+      if constexpr (std::is_signed_v<T>) {
+        m = _mm512_cmp_epi32_mask(v, rhs, avx512_int_predicate<Op>());
+      } else {
+        m = _mm512_cmp_epu32_mask(v, rhs, avx512_int_predicate<Op>());
+      }
+      _mm512_mask_compressstoreu_epi32(out + k, m, v);
+      k += std::popcount(static_cast<unsigned>(m));
+    }
+  } else {
+    const __m512i rhs = _mm512_set1_epi64(static_cast<long long>(operand));
+    for (; i + 8 <= n; i += 8) {
+      __m512i v = _mm512_loadu_si512(in + i);
+      __mmask8 m;
+      if constexpr (std::is_signed_v<T>) {
+        m = _mm512_cmp_epi64_mask(v, rhs, avx512_int_predicate<Op>());
+      } else {
+        m = _mm512_cmp_epu64_mask(v, rhs, avx512_int_predicate<Op>());
+      }
+      _mm512_mask_compressstoreu_epi64(out + k, m, v);
+      k += std::popcount(static_cast<unsigned>(m));
+    }
+  }
+  for (; i < n; ++i) {
+    out[k] = in[i];
+    k += compare<Op>(in[i], operand);
+  }
+  return k;
+}
+
+#elif defined(__AVX2__)
+
+/**
+ * @brief Builds the permutation table used to left-pack the selected lanes of a 256-bit vector.
+ *
+ * @tparam Lanes The number of lanes (8 for 32-bit and 4 for 64-bit elements).
+ */
+template <std::size_t Lanes>
+constexpr auto make_compress_table() {
+  std::array<std::array<std::uint32_t, 8>, (1 << Lanes)> table {};
+  for (std::size_t mask = 0; mask < table.size(); ++mask) {
+    std::size_t k = 0;
+    for (std::uint32_t lane = 0; lane < Lanes; ++lane) {
+      if ((mask >> lane) & 1) {
+        for (std::uint32_t part = 0; part < 8 / Lanes; ++part) {
+          table[mask][k++] = lane * (8 / Lanes) + part;
+        }
+      }
+    }
+  }
+  return table;
+}
+
+alignas(32) inline constexpr auto compress_table_8 = make_compress_table<8>();
+alignas(32) inline constexpr auto compress_table_4 = make_compress_table<4>();
+
+/// @brief Compares the lanes of two 256-bit vectors, returning all-ones lanes where `a Op b` holds.
+template <compare_op Op, typename T>
+__m256i avx2_compare(__m256i a, __m256i b) {
+  if constexpr (std::is_floating_point_v<T>) {
+    constexpr int predicates[] = { _CMP_LT_OQ, _CMP_LE_OQ, _CMP_GT_OQ, _CMP_GE_OQ, _CMP_EQ_OQ, _CMP_NEQ_UQ };
+    constexpr int predicate = predicates[static_cast<int>(Op)];
+    if constexpr (sizeof(T) == 4) {
+      return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), predicate));
+    } else {
+      return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), predicate));
+    }
+  } else {
+    if constexpr (std::is_unsigned_v<T>) {
+      // AVX2 only has signed comparisons; flipping the sign bit maps unsigned order onto signed order.
+      const __m256i sign = sizeof(T) == 4 ? _mm256_set1_epi32(INT32_MIN) : _mm256_set1_epi64x(INT64_MIN);
+      a = _mm256_xor_si256(a, sign);
+      b = _mm256_xor_si256(b, sign);
+    }
+    auto greater = [](__m256i x, __m256i y) { return sizeof(T) == 4 ? _mm256_cmpgt_epi32(x, y) : _mm256_cmpgt_epi64(x, y); };
+    auto equal = [](__m256i x, __m256i y) { return sizeof(T) == 4 ? _mm256_cmpeq_epi32(x, y) : _mm256_cmpeq_epi64(x, y); };
+    const __m256i ones = _mm256_set1_epi32(-1);
+    if constexpr (Op == compare_op::less) {
+      return greater(b, a);
+    } else if constexpr (Op == compare_op::less_equal) {
+      return _mm256_xor_si256(greater(a, b), ones);
+    } else if constexpr (Op == compare_op::greater) {
+      return greater(a, b);
+    } else if constexpr (Op == compare_op::greater_equal) {
+      return _mm256_xor_si256(greater(b, a), ones);
+    } else if constexpr (Op == compare_op::equal) {
+      return equal(a, b);
+    } else {
+      return _mm256_xor_si256(equal(a, b), ones);
+    }
+  }
+}
+
+/**
+ * @brief Vectorized `compress` for the predicate `value Op operand` (AVX2).
+ *
+ * Each 256-bit block is compared into a lane mask, left-packed with a
+ * permutation looked up from the mask and stored whole; the output position
+ * then advances by the number of selected lanes.
+ */
+template <compare_op Op, typename T>
+std::size_t compress_compare(const T* in, std::size_t n, T* out, T operand) {
+  constexpr std::size_t lanes = 32 / sizeof(T);
+  std::size_t i = 0;
+  std::size_t k = 0;
+  T operands[lanes];
+  std::fill_n(operands, lanes, operand);
+  const __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(operands));
+  for (; i + lanes <= n; i += lanes) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    __m256i selected = avx2_compare<Op, T>(v, rhs);
+    unsigned m;
+    const std::uint32_t* permutation;
+    if constexpr (sizeof(T) == 4) {
+      m = _mm256_movemask_ps(_mm256_castsi256_ps(selected));
+      permutation = compress_table_8[m].data();
+    } else {
+      m = _mm256_movemask_pd(_mm256_castsi256_pd(selected));
+      permutation = compress_table_4[m].data();
+    }
+    __m256i packed = _mm256_permutevar8x32_epi32(v, _mm256_load_si256(reinterpret_cast<const __m256i*>(permutation)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), packed);
+    k += std::popcount(m);
+  }
+  for (; i < n; ++i) {
+    out[k] = in[i];
+    k += compare<Op>(in[i], operand);
+  }
+  return k;
+}
+
+#endif
+
+} // namespace detail
+
+/**
+ * @brief A predicate comparing values against a fixed operand.
+ *
+ * Behaves like the lambda `[operand](const auto& value) { return value Op operand; }`,
+ * but `array::filter` recognizes it and, for arithmetic elements, selects with
+ * SIMD compress-stores when the target supports AVX2 or AVX-512. Create one
+ * with `less_than`, `less_equal`, `greater_than`, `greater_equal`, `equal_to`
+ * or `not_equal_to`.
+ *
+ * @tparam U The type of the operand.
+ * @tparam Op The comparison to perform.
+ */
+template <typename U, detail::compare_op Op>
+struct comparison {
+  /// @brief The right-hand side of the comparison.
+  U operand;
+
+  /// @return Whether `value Op operand` holds.
+  template <typename V>
+  constexpr bool operator()(const V& value) const {
+    return detail::compare<Op>(value, operand);
+  }
+};
+
+/// @return A predicate testing `value < operand`.
+template <typename U>
+constexpr comparison<U, detail::compare_op::less> less_than(U operand) { return { operand }; }
+/// @return A predicate testing `value <= operand`.
+template <typename U>
+constexpr comparison<U, detail::compare_op::less_equal> less_equal(U operand) { return { operand }; }
+/// @return A predicate testing `value > operand`.
+template <typename U>
+constexpr comparison<U, detail::compare_op::greater> greater_than(U operand) { return { operand }; }
+/// @return A predicate testing `value >= operand`.
+template <typename U>
+constexpr comparison<U, detail::compare_op::greater_equal> greater_equal(U operand) { return { operand }; }
+/// @return A predicate testing `value == operand`.
+template <typename U>
+constexpr comparison<U, detail::compare_op::equal> equal_to(U operand) { return { operand }; }
+/// @return A predicate testing `value != operand`.
+template <typename U>
+constexpr comparison<U, detail::compare_op::not_equal> not_equal_to(U operand) { return { operand }; }
+
+namespace detail {
+
+/// @brief Whether filtering elements of type `T` with `Pred` can use `compress_compare`.
+template <typename T, typename Pred>
+inline constexpr bool is_simd_comparison = false;
+
+template <typename T, typename U, compare_op Op>
+inline constexpr bool is_simd_comparison<T, comparison<U, Op>> =
+  has_simd_compress<T> && std::is_arithmetic_v<U> && !std::is_same_v<U, bool> && std::is_integral_v<U> == std::is_integral_v<T> && std::is_signed_v<U> == std::is_signed_v<T>;
+
+} // namespace detail
+
 /**
  * @brief A dynamic array class template.
  *
@@ -40,8 +578,6 @@ class array {
   /// @brief The length of the array.
   std::size_t length_ = 0;
 
-  static constexpr bool is_string = std::is_same_v<std::remove_cvref_t<T>, const char*> || std::is_same_v<std::remove_cvref_t<T>, char*> || std::is_same_v<std::remove_cvref_t<T>, std::string>;
-
   public:
   /// @brief The type of elements stored in the array.
   using value_type = T;
@@ -62,15 +598,164 @@ class array {
   /// @brief The type of const iterator.
   using const_iterator = const T*;
 
+  /**
+   * @brief A moving window over an array, created by `array::rolling`.
+   *
+   * Each aggregate returns one value per complete window, in order, and runs
+   * in O(n) regardless of the window size: sums slide a running total, and
+   * min/max keep a monotonic queue of candidate indices.
+   *
+   * The view only refers to the array, which must outlive it and must not be
+   * modified while it is used; call the aggregate in the same expression.
+   */
+  class rolling_view {
+    const array* source_;
+    size_type window_;
+
+    public:
+    /// @brief The type of the values returned by `mean`.
+    using mean_type = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+    constexpr rolling_view(const array& source, size_type window) :
+        source_(&source), window_(window) { }
+
+    /// @return The number of complete windows.
+    [[nodiscard]] constexpr size_type size() const noexcept {
+      return source_->size() < window_ ? 0 : source_->size() - window_ + 1;
+    }
+
+    /// @return A new array with the sum of each window.
+    constexpr array sum() const {
+      array result(size());
+      sum_range(result.begin(), 0, size());
+      return result;
+    }
+
+    /// @return A new array with the sum of each window, computed using several threads.
+    array sum(const parallel_t& policy) const {
+      array result(size());
+      run(policy, [&](size_type first, size_type last) { sum_range(result.begin(), first, last); });
+      return result;
+    }
+
+    /// @return A new array with the mean of each window, summed in `mean_type` so that narrow types do not overflow.
+    constexpr array<mean_type> mean() const {
+      array<mean_type> result(size());
+      sum_range(result.begin(), 0, size());
+      divide(result);
+      return result;
+    }
+
+    /// @return A new array with the mean of each window, computed using several threads.
+    array<mean_type> mean(const parallel_t& policy) const {
+      array<mean_type> result(size());
+      run(policy, [&](size_type first, size_type last) { sum_range(result.begin(), first, last); });
+      divide(result);
+      return result;
+    }
+
+    /// @return A new array with the smallest element of each window.
+    constexpr array min() const {
+      array result(size());
+      extreme_range(result.begin(), 0, size(), std::ranges::less {});
+      return result;
+    }
+
+    /// @return A new array with the smallest element of each window, computed using several threads.
+    array min(const parallel_t& policy) const {
+      array result(size());
+      run(policy, [&](size_type first, size_type last) { extreme_range(result.begin(), first, last, std::ranges::less {}); });
+      return result;
+    }
+
+    /// @return A new array with the largest element of each window.
+    constexpr array max() const {
+      array result(size());
+      extreme_range(result.begin(), 0, size(), std::ranges::greater {});
+      return result;
+    }
+
+    /// @return A new array with the largest element of each window, computed using several threads.
+    array max(const parallel_t& policy) const {
+      array result(size());
+      run(policy, [&](size_type first, size_type last) { extreme_range(result.begin(), first, last, std::ranges::greater {}); });
+      return result;
+    }
+
+    private:
+    /// @brief Splits the windows into one block per thread; blocks are independent.
+    template <typename F>
+    void run(const parallel_t& policy, F&& f) const {
+      size_type threads = detail::thread_count(policy, size(), 1 << 14);
+      detail::parallel_for(threads, [&](size_type t) {
+        f(t * size() / threads, (t + 1) * size() / threads);
+      });
+    }
+
+    /// @brief Writes the sums of windows `[first, last)` to `out`, accumulating in `U`.
+    template <typename U>
+    constexpr void sum_range(U* out, size_type first, size_type last) const {
+      if (first == last) return;
+      const_pointer in = source_->begin();
+      U total = static_cast<U>(in[first]);
+      for (size_type k = 1; k < window_; ++k) {
+        total = total + static_cast<U>(in[first + k]);
+      }
+      out[first] = total;
+      for (size_type j = first + 1; j < last; ++j) {
+        total = total + static_cast<U>(in[j + window_ - 1]) - static_cast<U>(in[j - 1]);
+        out[j] = total;
+      }
+    }
+
+    /**
+     * @brief Writes the extreme of windows `[first, last)` to `out`.
+     *
+     * @param better Returns true if its first argument should replace the second as the extreme.
+     */
+    template <typename Compare>
+    constexpr void extreme_range(pointer out, size_type first, size_type last, Compare better) const {
+      if (first == last) return;
+      const_pointer in = source_->begin();
+      // Ring buffer of indices whose values are strictly monotonic from front to back.
+      array<size_type> ring(window_);
+      size_type* queue = ring.begin();
+      size_type head = 0;
+      size_type count = 0;
+      for (size_type i = first; i < last + window_ - 1; ++i) {
+        if (count > 0 && queue[head] + window_ <= i) {
+          head = (head + 1) % window_;
+          --count;
+        }
+        while (count > 0 && !better(in[queue[(head + count - 1) % window_]], in[i])) {
+          --count;
+        }
+        queue[(head + count) % window_] = i;
+        ++count;
+        if (i + 1 >= first + window_) {
+          out[i + 1 - window_] = in[queue[head]];
+        }
+      }
+    }
+
+    /// @brief Turns the window sums in `sums` into means.
+    constexpr void divide(array<mean_type>& sums) const {
+      mean_type window = static_cast<mean_type>(window_);
+      for (mean_type& total : sums) {
+        total /= window;
+      }
+    }
+  };
+
   /// @brief Default constructor.
-  array() = default;
+  constexpr array() = default;
 
   /**
    * @brief Constructs an array with a specified capacity.
    *
    * @param capacity The initial capacity of the array.
    */
-  explicit array(size_type capacity) :
+  explicit constexpr array(size_type capacity) :
       array_(std::make_unique<T[]>(capacity)), capacity_(capacity), length_(capacity) { }
 
   /**
@@ -79,7 +764,7 @@ class array {
    * @param capacity The initial capacity of the array.
    * @param value The value to fill the array with.
    */
-  array(size_type capacity, const T& value) :
+  constexpr array(size_type capacity, const T& value) :
       array(capacity) {
     std::fill_n(array_.get(), capacity, value);
   }
@@ -89,7 +774,7 @@ class array {
    *
    * @param other The array to copy from.
    */
-  array(const array& other) :
+  constexpr array(const array& other) :
       array_(std::make_unique<T[]>(other.capacity_)),
       offset_(other.offset_), capacity_(other.capacity_), length_(other.length_) {
     std::copy_n(other.array_.get(), capacity_, array_.get());
@@ -100,20 +785,26 @@ class array {
    *
    * @param other The array to move from.
    */
-  array(array&&) noexcept = default;
+  constexpr array(array&& other) noexcept :
+      array_(std::move(other.array_)), offset_(std::exchange(other.offset_, 0)),
+      capacity_(std::exchange(other.capacity_, 0)), length_(std::exchange(other.length_, 0)) { }
   /**
    * @brief Move assignment operator.
    *
    * @param other The array to move from.
    * @return Reference to this array.
    */
-  array& operator=(array&&) noexcept = default;
+  constexpr array& operator=(array&& other) noexcept {
+    array temp(std::move(other));
+    swap(temp);
+    return *this;
+  }
   /**
    * @brief Constructs an array from an initializer list.
    *
    * @param list The initializer list to construct the array from.
    */
-  array(std::initializer_list<T> list) :
+  constexpr array(std::initializer_list<T> list) :
       array_(std::make_unique<T[]>(list.size())),
       capacity_(list.size()), length_(list.size()) {
     std::copy(list.begin(), list.end(), begin());
@@ -126,7 +817,7 @@ class array {
    * @param range The range to construct the array from.
    */
   template <typename Range>
-  array(Range&& range,
+  constexpr array(Range&& range,
     std::enable_if_t<std::ranges::range<Range>, int> = 0) :
       array_(std::make_unique<T[]>(std::ranges::distance(range))),
       offset_(0),
@@ -142,7 +833,7 @@ class array {
    * @param last The last iterator.
    */
   template <typename InputIt>
-  array(InputIt first, InputIt last,
+  constexpr array(InputIt first, InputIt last,
     std::enable_if_t<!std::is_integral_v<InputIt>, int> = 0) :
       array_(nullptr),
       offset_(0),
@@ -160,7 +851,7 @@ class array {
    * @param other The array to copy from.
    * @return Reference to this array.
    */
-  array& operator=(const array& other) {
+  constexpr array& operator=(const array& other) {
     if (this != &other) {
       array temp(other);
       swap(temp);
@@ -173,7 +864,7 @@ class array {
    * @param list The initializer list to assign from.
    * @return Reference to this array.
    */
-  array& operator=(std::initializer_list<T> list) {
+  constexpr array& operator=(std::initializer_list<T> list) {
     array temp(list);
     swap(temp);
     return *this;
@@ -183,7 +874,7 @@ class array {
    *
    * @param other The array to swap with.
    */
-  void swap(array& other) noexcept {
+  constexpr void swap(array& other) noexcept {
     using std::swap;
     swap(array_, other.array_);
     swap(offset_, other.offset_);
@@ -196,7 +887,7 @@ class array {
    * @param lhs The first array.
    * @param rhs The second array.
    */
-  friend void swap(array& lhs, array& rhs) noexcept {
+  friend constexpr void swap(array& lhs, array& rhs) noexcept {
     lhs.swap(rhs);
   }
   /**
@@ -205,7 +896,7 @@ class array {
    * @param index The index of the element.
    * @return Reference to the element.
    */
-  reference operator[](difference_type index) {
+  constexpr reference operator[](difference_type index) {
     if (index < 0 || static_cast<size_type>(index) >= size()) {
       throw std::out_of_range("Index out of bounds");
     }
@@ -218,7 +909,7 @@ class array {
    * @param index The index of the element.
    * @return Constant reference to the element.
    */
-  const_reference operator[](difference_type index) const {
+  constexpr const_reference operator[](difference_type index) const {
     if (index < 0 || static_cast<size_type>(index) >= size()) {
       throw std::out_of_range("Index out of bounds");
     }
@@ -230,7 +921,7 @@ class array {
    * @param n The scalar to multiply by.
    * @return A new array with the elements repeated n times.
    */
-  array operator*(size_type n) const {
+  constexpr array operator*(size_type n) const {
     array result;
     result.reserve(size() * n);
     for (size_type i = 0; i < n; ++i) {
@@ -244,7 +935,7 @@ class array {
    * @param n The scalar to multiply by.
    * @return Reference to this array.
    */
-  array& operator*=(size_type n) {
+  constexpr array& operator*=(size_type n) {
     *this = *this * n;
     return *this;
   }
@@ -254,7 +945,7 @@ class array {
    * @param other The array to concatenate with.
    * @return A new array with the elements of both arrays.
    */
-  array operator+(const array& other) const {
+  constexpr array operator+(const array& other) const {
     array result;
     result.reserve(size() + other.size());
     result.insert(result.end(), begin(), end());
@@ -267,7 +958,7 @@ class array {
    * @param other The array to concatenate.
    * @return Reference to this array.
    */
-  array& operator+=(const array& other) {
+  constexpr array& operator+=(const array& other) {
     insert(end(), other.begin(), other.end());
     return *this;
   }
@@ -277,7 +968,7 @@ class array {
    * @param other The array to compare with.
    * @return True if the arrays are equal, false otherwise.
    */
-  bool operator==(const array& other) const {
+  constexpr bool operator==(const array& other) const {
     return std::equal(begin(), end(), other.begin(), other.end());
   }
   /**
@@ -286,7 +977,7 @@ class array {
    * @param other The array to compare with.
    * @return The result of the comparison.
    */
-  auto operator<=>(const array& other) const {
+  constexpr auto operator<=>(const array& other) const {
     return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
   }
   /**
@@ -314,7 +1005,7 @@ class array {
    *
    * @param value The value to add.
    */
-  void unshift(const T& value) {
+  constexpr void unshift(const T& value) {
     if (length_ == capacity_) {
       size_type new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
       auto new_array = std::make_unique<T[]>(new_capacity);
@@ -341,7 +1032,7 @@ class array {
    * @return The first element of the array.
    * @throws std::out_of_range If the array is empty.
    */
-  T shift() {
+  constexpr T shift() {
     if (empty()) {
       throw std::out_of_range("Array is empty");
     }
@@ -367,12 +1058,9 @@ class array {
    *
    * @param value The value to add.
    */
-  void push(const T& value) {
-    if (length_ == capacity_) {
-      size_type new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
-      reserve(new_capacity);
-    }
-    array_[length_++] = value;
+  constexpr void push(const T& value) {
+    make_room(1);
+    array_[offset_ + length_++] = value;
   }
   /**
    * @brief Removes and returns the last element of the array.
@@ -380,11 +1068,11 @@ class array {
    * @return The last element of the array.
    * @throws std::out_of_range If the array is empty.
    */
-  T pop() {
+  constexpr T pop() {
     if (empty()) {
       throw std::out_of_range("Array is empty");
     }
-    return std::move(array_[--length_]);
+    return std::move(array_[offset_ + --length_]);
   }
   /**
    * @brief Accesses an element by index with bounds checking.
@@ -393,7 +1081,7 @@ class array {
    * @return Reference to the element.
    * @throws std::out_of_range If the index is out of bounds.
    */
-  reference at(difference_type index) {
+  constexpr reference at(difference_type index) {
     return (*this)[index];
   }
   /**
@@ -403,37 +1091,76 @@ class array {
    * @return Constant reference to the element.
    * @throws std::out_of_range If the index is out of bounds.
    */
-  const_reference at(difference_type index) const {
+  constexpr const_reference at(difference_type index) const {
     return (*this)[index];
   }
   /**
    * @brief Applies a function to each element of the array.
    *
+   * @tparam F The type of the function.
    * @param f The function to apply.
    */
-  void for_each(const std::function<void(T)>& f) const {
-    std::for_each(begin(), end(), f);
+  template <std::invocable<T&> F>
+  constexpr void for_each(F&& f) {
+    for (auto& value : *this) {
+      std::invoke(f, value);
+    }
+  }
+  /**
+   * @brief Applies a function to each element of the array (const version).
+   *
+   * @tparam F The type of the function.
+   * @param f The function to apply.
+   */
+  template <std::invocable<const T&> F>
+  constexpr void for_each(F&& f) const {
+    for (const auto& value : *this) {
+      std::invoke(f, value);
+    }
   }
   /**
    * @brief Applies a function to each element of the array, passing the index as well.
    *
+   * @tparam F The type of the function.
    * @param f The function to apply.
    */
-  void for_each(const std::function<void(T, size_type)>& f) const {
+  template <std::invocable<T&, size_type> F>
+  constexpr void for_each(F&& f) {
+    pointer data = begin();
     for (size_type i = 0; i < size(); ++i) {
-      f((*this)[i], i);
+      std::invoke(f, data[i], i);
+    }
+  }
+  /**
+   * @brief Applies a function to each element of the array, passing the index as well (const version).
+   *
+   * @tparam F The type of the function.
+   * @param f The function to apply.
+   */
+  template <std::invocable<const T&, size_type> F>
+  constexpr void for_each(F&& f) const {
+    const_pointer data = begin();
+    for (size_type i = 0; i < size(); ++i) {
+      std::invoke(f, data[i], i);
     }
   }
   /**
    * @brief Filters the array using a predicate.
    *
+   * The predicate is evaluated once per element while the selected elements
+   * are compacted into a result sized for the worst case, which is trimmed
+   * afterwards when most of it is unused.
+   *
    * @tparam Pred The type of the predicate.
    * @param pred The predicate to use for filtering.
    * @return A new array with the elements that satisfy the predicate.
    */
-  template <std::invocable<T> Pred>
-  array filter(Pred pred) const {
-    return array(std::ranges::filter_view(std::ranges::subrange(begin(), end()), pred));
+  template <std::invocable<const T&> Pred>
+  constexpr array filter(Pred&& pred) const {
+    array result;
+    filter_into(result, pred);
+    result.trim();
+    return result;
   }
   /**
    * @brief Filters the array using a predicate, passing the index as well.
@@ -442,15 +1169,55 @@ class array {
    * @param pred The predicate to use for filtering.
    * @return A new array with the elements that satisfy the predicate.
    */
-  template <std::invocable<T, size_type> Pred>
-  array filter(Pred pred) const {
+  template <std::invocable<const T&, size_type> Pred>
+  constexpr array filter(Pred&& pred) const {
     array result;
-    for (size_type i = 0; i < size(); ++i) {
-      if (pred((*this)[i], i)) {
-        result.push((*this)[i]);
+    filter_into(result, pred);
+    result.trim();
+    return result;
+  }
+  /**
+   * @brief Filters the array into an existing array.
+   *
+   * Replaces the contents of `out` with the elements that satisfy the
+   * predicate. The buffer of `out` is reused when it can hold `size()`
+   * elements, so filtering successive batches into the same array does not
+   * allocate. `out` may be this array.
+   *
+   * @tparam Pred The type of the predicate.
+   * @param out The array receiving the selected elements.
+   * @param pred The predicate to use for filtering.
+   * @return Reference to `out`.
+   */
+  template <std::invocable<const T&> Pred>
+  constexpr array& filter_into(array& out, Pred&& pred) const {
+    const_pointer in = begin();
+    size_type n = size();
+    pointer dest = out.prepare_output(n);
+    if constexpr (detail::is_simd_comparison<T, std::remove_cvref_t<Pred>>) {
+      if (!std::is_constant_evaluated() && operand_fits(pred.operand)) {
+        out.length_ = compress_with(pred, in, n, dest);
+        return out;
       }
     }
-    return result;
+    out.length_ = detail::compress(in, n, dest, pred);
+    return out;
+  }
+  /**
+   * @brief Filters the array into an existing array, passing the index as well.
+   *
+   * @tparam Pred The type of the predicate.
+   * @param out The array receiving the selected elements.
+   * @param pred The predicate to use for filtering.
+   * @return Reference to `out`.
+   */
+  template <std::invocable<const T&, size_type> Pred>
+  constexpr array& filter_into(array& out, Pred&& pred) const {
+    const_pointer in = begin();
+    size_type n = size();
+    pointer dest = out.prepare_output(n);
+    out.length_ = detail::compress_indexed(in, n, dest, pred);
+    return out;
   }
   /**
    * @brief Maps the array using a function.
@@ -459,9 +1226,15 @@ class array {
    * @param f The function to use for mapping.
    * @return A new array with the mapped elements.
    */
-  template <std::invocable<T> F>
-  auto map(F f) const -> array<std::invoke_result_t<F, T>> {
-    return array<std::invoke_result_t<F, T>>(std::ranges::transform_view(std::ranges::subrange(begin(), end()), f));
+  template <std::invocable<const T&> F>
+  constexpr auto map(F&& f) const -> array<std::remove_cvref_t<std::invoke_result_t<F&, const T&>>> {
+    array<std::remove_cvref_t<std::invoke_result_t<F&, const T&>>> result(size());
+    const_pointer data = begin();
+    auto out = result.begin();
+    for (size_type i = 0; i < size(); ++i) {
+      out[i] = std::invoke(f, data[i]);
+    }
+    return result;
   }
   /**
    * @brief Maps the array using a function, passing the index as well.
@@ -470,53 +1243,387 @@ class array {
    * @param f The function to use for mapping.
    * @return A new array with the mapped elements.
    */
-  template <std::invocable<T, size_type> F>
-  auto map(F f) const -> array<std::invoke_result_t<F, T, size_type>> {
-    array<std::invoke_result_t<F, T, size_type>> result;
-    result.reserve(size());
+  template <std::invocable<const T&, size_type> F>
+  constexpr auto map(F&& f) const -> array<std::remove_cvref_t<std::invoke_result_t<F&, const T&, size_type>>> {
+    array<std::remove_cvref_t<std::invoke_result_t<F&, const T&, size_type>>> result(size());
+    const_pointer data = begin();
+    auto out = result.begin();
     for (size_type i = 0; i < size(); ++i) {
-      result.push(f((*this)[i], i));
+      out[i] = std::invoke(f, data[i], i);
     }
     return result;
   }
   /**
    * @brief Reduces the array to a single value using a function.
    *
-   * @tparam U The type of the result.
+   * The function is called as `f(accumulator, value)` or, if it accepts a third
+   * argument, `f(accumulator, value, index)`.
+   *
+   * @tparam U The type of the result (default is what `f` returns when called with `initial`).
+   * @tparam F The type of the function.
+   * @tparam I The type of the initial value.
    * @param f The function to use for reducing.
    * @param initial The initial value.
    * @return The reduced value.
    */
-  template <typename U>
-  U reduce(const std::function<U(U, T)>& f, U initial) const {
-    return std::accumulate(begin(), end(), initial, f);
+  template <typename U = void, typename F, typename I, typename R = detail::reduce_result_t<U, F, I, T>>
+    requires std::invocable<F&, R, const T&> || std::invocable<F&, R, const T&, size_type>
+  constexpr R reduce(F&& f, I&& initial) const {
+    return fold<R>(f, R(std::forward<I>(initial)), 0);
   }
   /**
-   * @brief Reduces the array to a single value using a function.
+   * @brief Reduces the array to a single value using a function, starting from the first element.
    *
-   * @tparam Func The type of the function.
-   * @param func The function to use for reducing.
-   * @param initial The initial value.
+   * The function is called as `f(accumulator, value)` or, if it accepts a third
+   * argument, `f(accumulator, value, index)`, starting at index 1.
+   *
+   * @tparam F The type of the function.
+   * @param f The function to use for reducing.
    * @return The reduced value.
+   * @throws std::out_of_range If the array is empty.
    */
-  template <typename Func>
-  T reduce(Func func, T initial) const {
-    T accumulator = initial;
-    for (uint64_t i = 0; i < length_; ++i) {
-      accumulator = func(accumulator, array_[i]);
+  template <typename F>
+    requires std::invocable<F&, T, const T&> || std::invocable<F&, T, const T&, size_type>
+  constexpr T reduce(F&& f) const {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
     }
-    return accumulator;
+    return fold<T>(f, *begin(), 1);
+  }
+  /**
+   * @brief Computes the running totals of the array.
+   *
+   * Element `i` of the result is `op(... op(a[0], a[1]) ..., a[i])`.
+   *
+   * @tparam Op The type of the binary operation.
+   * @param op The binary operation (default is `std::plus`).
+   * @return A new array with the running totals.
+   */
+  template <typename Op = std::plus<>>
+  constexpr array inclusive_scan(Op op = {}) const {
+    array result(size());
+    if (!empty()) scan_block(begin(), size(), result.begin(), op, *begin(), 1);
+    return result;
+  }
+  /**
+   * @brief Computes the running totals of the array using several threads.
+   *
+   * The array is split into one block per thread. Each thread reduces its
+   * block, the block totals are scanned, then each thread scans its block
+   * starting from the total of the blocks before it. `op` must be associative.
+   *
+   * @tparam Op The type of the binary operation.
+   * @param policy The parallel policy.
+   * @param op The binary operation (default is `std::plus`).
+   * @return A new array with the running totals.
+   */
+  template <typename Op = std::plus<>>
+  array inclusive_scan(const parallel_t& policy, Op op = {}) const {
+    array result(size());
+    if (!empty()) parallel_scan(policy, result.begin(), op, nullptr);
+    return result;
+  }
+  /**
+   * @brief Computes the running totals of the array, excluding the current element.
+   *
+   * Element `i` of the result is `op(... op(initial, a[0]) ..., a[i - 1])`.
+   *
+   * @tparam Op The type of the binary operation.
+   * @param initial The first value of the result.
+   * @param op The binary operation (default is `std::plus`).
+   * @return A new array with the running totals.
+   */
+  template <typename Op = std::plus<>>
+  constexpr array exclusive_scan(T initial, Op op = {}) const {
+    array result(size());
+    if (!empty()) {
+      scan_block(begin(), size() - 1, result.begin() + 1, op, initial, 0);
+      result.array_[0] = std::move(initial);
+    }
+    return result;
+  }
+  /**
+   * @brief Computes the running totals of the array, excluding the current element, using several threads.
+   *
+   * @tparam Op The type of the binary operation.
+   * @param policy The parallel policy.
+   * @param initial The first value of the result.
+   * @param op The binary operation (default is `std::plus`).
+   * @return A new array with the running totals.
+   */
+  template <typename Op = std::plus<>>
+  array exclusive_scan(const parallel_t& policy, T initial, Op op = {}) const {
+    array result(size());
+    if (!empty()) parallel_scan(policy, result.begin(), op, &initial);
+    return result;
+  }
+  /**
+   * @brief Aggregates over a moving window.
+   *
+   * @code
+   * array<int> a = { 1, 3, 2, 5 };
+   * a.rolling(2).sum(); // [ 4, 5, 7 ]
+   * a.rolling(2).max(); // [ 3, 3, 5 ]
+   * @endcode
+   *
+   * The view refers to this array, so it must not outlive it. Calling
+   * `rolling` on a temporary array is not allowed.
+   *
+   * @param window The number of elements in each window.
+   * @return A view whose aggregates have one value per complete window.
+   * @throws std::invalid_argument If the window is empty.
+   */
+  [[nodiscard]] constexpr auto rolling(size_type window) const& {
+    if (window == 0) {
+      throw std::invalid_argument("Window must not be empty");
+    }
+    return rolling_view(*this, window);
+  }
+  /// @brief Deleted so that a view cannot refer to a temporary array.
+  auto rolling(size_type window) const&& = delete;
+  /**
+   * @brief Splits the array into the elements that satisfy a predicate and those that do not.
+   *
+   * The predicate is evaluated once per element and both parts keep the
+   * original order.
+   *
+   * @tparam Pred The type of the predicate.
+   * @param pred The predicate to use for partitioning.
+   * @return A pair of new arrays with the elements that satisfy and do not satisfy the predicate.
+   */
+  template <std::invocable<const T&> Pred>
+  constexpr std::pair<array, array> partition(Pred&& pred) const {
+    const_pointer in = begin();
+    size_type n = size();
+    array selected;
+    pointer buffer = selected.prepare_output(n);
+    // Selected elements grow from the front of the buffer, rejected ones from the back.
+    size_type front = 0;
+    size_type back = n;
+    for (size_type i = 0; i < n; ++i) {
+      bool keep = std::invoke(pred, in[i]);
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        buffer[front] = in[i];
+        buffer[back - 1] = in[i];
+        front += keep;
+        back -= !keep;
+      } else if (keep) {
+        buffer[front++] = in[i];
+      } else {
+        buffer[--back] = in[i];
+      }
+    }
+    array rejected(n - back);
+    for (size_type i = 0; i < rejected.size(); ++i) {
+      rejected.array_[i] = std::move(buffer[n - 1 - i]);
+    }
+    selected.length_ = front;
+    selected.trim();
+    return { std::move(selected), std::move(rejected) };
+  }
+  /**
+   * @brief Splits the array into the elements that satisfy a predicate and those that do not, using several threads.
+   *
+   * Each thread records the predicate for its block and counts the selected
+   * elements; the counts give every block its output position, then each
+   * thread copies its block. Both parts keep the original order.
+   *
+   * @tparam Pred The type of the predicate.
+   * @param policy The parallel policy.
+   * @param pred The predicate to use for partitioning.
+   * @return A pair of new arrays with the elements that satisfy and do not satisfy the predicate.
+   */
+  template <std::invocable<const T&> Pred>
+  std::pair<array, array> partition(const parallel_t& policy, Pred&& pred) const {
+    const_pointer in = begin();
+    size_type n = size();
+    size_type threads = detail::thread_count(policy, n, 1 << 14);
+    std::vector<unsigned char> keep(n);
+    std::vector<size_type> counts(threads + 1, 0);
+    detail::parallel_for(threads, [&](size_type t) {
+      auto [first, last] = block(t, threads);
+      size_type count = 0;
+      for (size_type i = first; i < last; ++i) {
+        keep[i] = static_cast<bool>(std::invoke(pred, in[i]));
+        count += keep[i];
+      }
+      counts[t + 1] = count;
+    });
+    std::partial_sum(counts.begin(), counts.end(), counts.begin());
+
+    array selected(counts.back());
+    array rejected(n - counts.back());
+    detail::parallel_for(threads, [&](size_type t) {
+      auto [first, last] = block(t, threads);
+      pointer yes = selected.begin() + counts[t];
+      pointer no = rejected.begin() + (first - counts[t]);
+      for (size_type i = first; i < last; ++i) {
+        if (keep[i]) {
+          *yes++ = in[i];
+        } else {
+          *no++ = in[i];
+        }
+      }
+    });
+    return { std::move(selected), std::move(rejected) };
+  }
+
+  /**
+   * @brief Removes duplicate elements, keeping the first occurrence of each.
+   *
+   * Elements are deduplicated with a `std::hash` open-addressing table.
+   *
+   * @return A new array with the distinct elements in their original order.
+   */
+  array distinct() const {
+    const_pointer in = begin();
+    size_type n = size();
+    array result;
+    pointer out = result.prepare_output(n);
+    std::vector<std::uint64_t> hashes;
+    detail::hash_index index;
+    for (size_type i = 0; i < n; ++i) {
+      std::uint64_t hash = detail::mix_hash(std::hash<T> {}(in[i]));
+      auto equal = [&](size_type k) { return out[k] == in[i]; };
+      auto hash_of = [&](size_type k) { return hashes[k]; };
+      if (index.insert(hash, result.length_, equal, hash_of).second) {
+        out[result.length_++] = in[i];
+        hashes.push_back(hash);
+      }
+    }
+    result.trim();
+    return result;
+  }
+  /**
+   * @brief Removes duplicate elements, keeping the first occurrence of each, using several threads.
+   *
+   * The positions are radix-partitioned by hash, so equal elements share a
+   * partition, and each thread deduplicates its partitions with private
+   * tables. The first occurrences are then copied in order.
+   *
+   * @param policy The parallel policy.
+   * @return A new array with the distinct elements in their original order.
+   */
+  array distinct(const parallel_t& policy) const {
+    const_pointer in = begin();
+    size_type threads = detail::thread_count(policy, size(), 1 << 15);
+    if (threads <= 1) return distinct();
+    auto parts = detail::partition_by_hash(size(), threads, [&](size_type i) { return detail::mix_hash(std::hash<T> {}(in[i])); });
+    std::vector<unsigned char> keep(size(), 0);
+    size_type partitions = parts.bounds.size() - 1;
+    detail::parallel_for(threads, [&](size_type t) {
+      std::vector<size_type> firsts;
+      for (size_type p = t; p < partitions; p += threads) {
+        detail::hash_index index;
+        firsts.clear();
+        for (size_type k = parts.bounds[p]; k < parts.bounds[p + 1]; ++k) {
+          size_type i = parts.order[k];
+          auto equal = [&](size_type j) { return in[firsts[j]] == in[i]; };
+          auto hash_of = [&](size_type j) { return parts.hashes[firsts[j]]; };
+          if (index.insert(parts.hashes[i], firsts.size(), equal, hash_of).second) {
+            firsts.push_back(i);
+            keep[i] = 1;
+          }
+        }
+      }
+    });
+    return gather(keep, threads);
+  }
+
+  /**
+   * @brief Counts the elements by key.
+   *
+   * @tparam KeyFn The type of the key function.
+   * @param key_fn The function returning the key of an element.
+   * @return A map from each key to its number of elements, in order of first occurrence.
+   */
+  template <std::invocable<const T&> KeyFn>
+  auto count_by(KeyFn&& key_fn) const -> hash_map<detail::key_result_t<KeyFn, T>, size_type> {
+    return build_map<detail::key_result_t<KeyFn, T>, size_type>(key_fn, [](size_type& count, const T&) { ++count; });
+  }
+  /**
+   * @brief Counts the elements by key, using several threads.
+   *
+   * @tparam KeyFn The type of the key function.
+   * @param policy The parallel policy.
+   * @param key_fn The function returning the key of an element.
+   * @return A map from each key to its number of elements, in order of first occurrence.
+   */
+  template <std::invocable<const T&> KeyFn>
+  auto count_by(const parallel_t& policy, KeyFn&& key_fn) const -> hash_map<detail::key_result_t<KeyFn, T>, size_type> {
+    return build_map<detail::key_result_t<KeyFn, T>, size_type>(policy, key_fn, [](size_type& count, const T&) { ++count; });
+  }
+
+  /**
+   * @brief Groups the elements by key.
+   *
+   * @tparam KeyFn The type of the key function.
+   * @param key_fn The function returning the key of an element.
+   * @return A map from each key to its elements in their original order, in order of first occurrence.
+   */
+  template <std::invocable<const T&> KeyFn>
+  auto group_by(KeyFn&& key_fn) const -> hash_map<detail::key_result_t<KeyFn, T>, array> {
+    return build_map<detail::key_result_t<KeyFn, T>, array>(key_fn, [](array& group, const T& value) { group.push(value); });
+  }
+  /**
+   * @brief Groups the elements by key, using several threads.
+   *
+   * @tparam KeyFn The type of the key function.
+   * @param policy The parallel policy.
+   * @param key_fn The function returning the key of an element.
+   * @return A map from each key to its elements in their original order, in order of first occurrence.
+   */
+  template <std::invocable<const T&> KeyFn>
+  auto group_by(const parallel_t& policy, KeyFn&& key_fn) const -> hash_map<detail::key_result_t<KeyFn, T>, array> {
+    return build_map<detail::key_result_t<KeyFn, T>, array>(policy, key_fn, [](array& group, const T& value) { group.push(value); });
+  }
+
+  /**
+   * @brief Indexes the elements by key; the last element with a key wins.
+   *
+   * @tparam KeyFn The type of the key function.
+   * @param key_fn The function returning the key of an element.
+   * @return A map from each key to its last element, in order of first occurrence.
+   */
+  template <std::invocable<const T&> KeyFn>
+  auto index_by(KeyFn&& key_fn) const -> hash_map<detail::key_result_t<KeyFn, T>, T> {
+    return build_map<detail::key_result_t<KeyFn, T>, T>(key_fn, [](T& slot, const T& value) { slot = value; });
+  }
+  /**
+   * @brief Indexes the elements by key using several threads; the last element with a key wins.
+   *
+   * @tparam KeyFn The type of the key function.
+   * @param policy The parallel policy.
+   * @param key_fn The function returning the key of an element.
+   * @return A map from each key to its last element, in order of first occurrence.
+   */
+  template <std::invocable<const T&> KeyFn>
+  auto index_by(const parallel_t& policy, KeyFn&& key_fn) const -> hash_map<detail::key_result_t<KeyFn, T>, T> {
+    return build_map<detail::key_result_t<KeyFn, T>, T>(policy, key_fn, [](T& slot, const T& value) { slot = value; });
   }
   /**
    * @brief Reverses the array.
    *
    * @return A new array with the elements in reverse order.
    */
-  array reverse() const {
+  constexpr array reverse() const {
     array result(*this);
     std::ranges::reverse(result);
     return result;
   }
+  /**
+   * @brief Sorts the array.
+   *
+   * @tparam Compare The type of the comparison function.
+   * @param comp The comparison function (default is `std::ranges::less`).
+   * @return A new array with the elements in sorted order.
+   */
+  template <typename Compare = std::ranges::less>
+  constexpr array sort(Compare comp = {}) const {
+    array result(*this);
+    std::ranges::sort(result, comp);
+    return result;
+  }
   /**
    * @brief Slices the array.
    *
@@ -524,7 +1631,7 @@ class array {
    * @param end The end index (default is -1, which means the end of the array).
    * @return A new array with the sliced elements.
    */
-  array slice(difference_type start, difference_type end = -1) const {
+  constexpr array slice(difference_type start, difference_type end = -1) const {
     if (end < 0) end += size();
     start = std::clamp<difference_type>(start, 0, size());
     end = std::clamp<difference_type>(end, start, size());
@@ -539,21 +1646,126 @@ class array {
   std::string join(std::string_view sep = ",") const {
     return std::accumulate(begin(), end(), std::string {},
       [&sep](const std::string& a, const T& b) {
-        return a.empty() ? to_string(b) : a + std::string(sep) + to_string(b);
+        return a.empty() ? detail::format_element(b) : a + std::string(sep) + detail::format_element(b);
       });
   }
+  /**
+   * @brief Parses a separated list of numbers.
+   *
+   * Accepts the output of both `join(sep)` and `operator<<` (`[ 1, 2, 3 ]`).
+   * Whitespace around values is ignored. The input is scanned once to count
+   * the values so that the result is allocated exactly once.
+   *
+   * @param text The text to parse.
+   * @param sep The separator between values (default is ",").
+   * @return A new array with the parsed values.
+   * @throws std::invalid_argument If the separator is empty or a value cannot be parsed.
+   */
+  static array parse(std::string_view text, std::string_view sep = ",")
+    requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+  {
+    text = parse_body(text, sep);
+    if (text.empty()) return array();
+    array result(detail::count_separators(text, sep) + 1);
+    detail::parse_numbers(text, sep, result.begin());
+    return result;
+  }
+  /**
+   * @brief Parses a separated list of numbers using several threads.
+   *
+   * The input is split into chunks at separator boundaries. Each thread counts
+   * the values of its chunk, then parses them into its slice of the result.
+   *
+   * @param policy The parallel policy.
+   * @param text The text to parse.
+   * @param sep The separator between values (default is ",").
+   * @return A new array with the parsed values.
+   * @throws std::invalid_argument If the separator is empty or a value cannot be parsed.
+   */
+  static array parse(const parallel_t& policy, std::string_view text, std::string_view sep = ",")
+    requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+  {
+    text = parse_body(text, sep);
+    size_type threads = detail::thread_count(policy, text.size(), 1 << 16);
+    if (threads == 1) return parse(text, sep);
+
+    // Chunk k spans [bounds[k], ends[k]); consecutive chunks are split by one separator.
+    std::vector<size_type> bounds { 0 };
+    std::vector<size_type> ends;
+    for (size_type k = 1; k < threads; ++k) {
+      auto pos = text.find(sep, std::max(k * text.size() / threads, bounds.back()));
+      if (pos == std::string_view::npos) break;
+      ends.push_back(pos);
+      bounds.push_back(pos + sep.size());
+    }
+    ends.push_back(text.size());
+
+    size_type chunks = bounds.size();
+    std::vector<size_type> offsets(chunks + 1, 0);
+    detail::parallel_for(chunks, [&](size_type k) {
+      offsets[k + 1] = detail::count_separators(text.substr(bounds[k], ends[k] - bounds[k]), sep) + 1;
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    array result(offsets.back());
+    detail::parallel_for(chunks, [&](size_type k) {
+      detail::parse_numbers(text.substr(bounds[k], ends[k] - bounds[k]), sep, result.begin() + offsets[k]);
+    });
+    return result;
+  }
+  /**
+   * @brief Reads and parses a separated list of numbers from a stream.
+   *
+   * @param is The input stream, read until its end.
+   * @param sep The separator between values (default is ",").
+   * @return A new array with the parsed values.
+   * @throws std::invalid_argument If the separator is empty or a value cannot be parsed.
+   */
+  static array from_stream(std::istream& is, std::string_view sep = ",")
+    requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+  {
+    std::string text { std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+    return parse(text, sep);
+  }
+  /**
+   * @brief Reads and parses a separated list of numbers from a stream using several threads.
+   *
+   * @param policy The parallel policy.
+   * @param is The input stream, read until its end.
+   * @param sep The separator between values (default is ",").
+   * @return A new array with the parsed values.
+   * @throws std::invalid_argument If the separator is empty or a value cannot be parsed.
+   */
+  static array from_stream(const parallel_t& policy, std::istream& is, std::string_view sep = ",")
+    requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+  {
+    std::string text { std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+    return parse(policy, text, sep);
+  }
   /**
    * @brief Reserves memory for the array.
    *
    * @param new_capacity The new capacity of the array.
    */
-  void reserve(size_type new_capacity) {
+  constexpr void reserve(size_type new_capacity) {
     if (new_capacity > capacity_) {
       auto new_array = std::make_unique<T[]>(new_capacity);
       std::copy_n(array_.get() + offset_, size(), new_array.get());
       array_ = std::move(new_array);
       capacity_ = new_capacity;
-      length_ -= offset_;
+      offset_ = 0;
+    }
+  }
+
+  /**
+   * @brief Reduces the capacity of the array to its size.
+   */
+  constexpr void shrink_to_fit() {
+    if (capacity_ > size()) {
+      auto new_array = std::make_unique<T[]>(size());
+      std::move(begin(), end(), new_array.get());
+      array_ = std::move(new_array);
+      capacity_ = size();
       offset_ = 0;
     }
   }
@@ -582,16 +1794,12 @@ class array {
    *       in the array are invalidated.
    */
   template <typename InputIt>
-  void insert(const_iterator pos, InputIt first, InputIt last) {
+  constexpr void insert(const_iterator pos, InputIt first, InputIt last) {
     size_type n = std::distance(first, last);
     assert(pos >= begin() && pos <= end()); // Ensure pos is within valid range
     auto pos_index = pos - begin();
-    if (size() + n > capacity_) {
-      reserve((size() + n) * 2);
-      pos = begin() + pos_index; // Update pos after reserve
-    }
-    pos_index = pos - begin();
-    assert(pos_index + n <= capacity_); // Ensure we don't move elements out of bounds
+    make_room(n);
+    assert(offset_ + size() + n <= capacity_); // Ensure we don't move elements out of bounds
     std::move_backward(begin() + pos_index, end(), end() + n);
     std::copy(first, last, begin() + pos_index);
     length_ += n;
@@ -617,53 +1825,265 @@ class array {
    * @note If the array is reallocated, all iterators, pointers, and references to elements
    *       in the array are invalidated.
    */
-  void insert(const_iterator pos, const T& value) {
+  constexpr void insert(const_iterator pos, const T& value) {
     assert(pos >= begin() && pos <= end()); // Ensure pos is within valid range
     auto pos_index = pos - begin();
-    if (size() + 1 > capacity_) {
-      reserve((size() + 1) * 2);
-      pos = begin() + pos_index; // Update pos after reserve
-    }
-    pos_index = pos - begin();
+    make_room(1);
     // Shift elements to the right
     std::move_backward(begin() + pos_index, end(), end() + 1);
     // Insert the new element
-    array_[pos_index] = value;
+    array_[offset_ + pos_index] = value;
     ++length_;
   }
 
   /// @return The the size of the array.
-  [[nodiscard]] size_type size() const noexcept {
+  [[nodiscard]] constexpr size_type size() const noexcept {
     size_type s = length_;
     return s;
   }
   /// @return The capacity of the array.
-  [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+  [[nodiscard]] constexpr size_type capacity() const noexcept { return capacity_; }
   /// @brief Determines if the array is empty.
-  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+  [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
   /// @brief Determines if the array is full.
-  [[nodiscard]] bool full() const noexcept { return size() == capacity_; }
+  [[nodiscard]] constexpr bool full() const noexcept { return size() == capacity_; }
   /// @return An iterator to the beginning of the array.
-  iterator begin() noexcept {
+  constexpr iterator begin() noexcept {
     return array_.get() + offset_;
   }
   /// @return A const iterator to the beginning of the array.
-  const_iterator begin() const noexcept { return array_.get() + offset_; }
+  constexpr const_iterator begin() const noexcept { return array_.get() + offset_; }
   /// @return An iterator to the end of the array.
-  iterator end() noexcept {
+  constexpr iterator end() noexcept {
     return array_.get() + offset_ + length_;
   }
   /// @return A const iterator to the end of the array.
-  const_iterator end() const noexcept { return array_.get() + offset_ + length_; }
+  constexpr const_iterator end() const noexcept { return array_.get() + offset_ + length_; }
 
   private:
+  /**
+   * @brief Ensures that `n` more elements fit after the last element.
+   *
+   * Grows the capacity geometrically, which also moves the elements back to
+   * the front of the buffer.
+   */
+  constexpr void make_room(size_type n) {
+    if (offset_ + length_ + n > capacity_) {
+      reserve(std::max(capacity_ == 0 ? 1 : capacity_ * 2, length_ + n));
+    }
+  }
+
+  /**
+   * @brief Empties the array and returns a buffer with room for `n` elements.
+   *
+   * The current buffer is kept if it is large enough. Its elements are left
+   * in place, so the buffer may be the source of the elements written to it.
+   */
+  constexpr pointer prepare_output(size_type n) {
+    if (capacity_ < n) {
+      array_ = std::make_unique<T[]>(n);
+      capacity_ = n;
+    }
+    offset_ = 0;
+    length_ = 0;
+    return array_.get();
+  }
+
+  /// @brief Releases the unused capacity of a worst-case sized result once it exceeds half of the buffer.
+  constexpr void trim() {
+    if (size() < capacity_ / 2) {
+      shrink_to_fit();
+    }
+  }
+
+  /// @brief Determines if comparing against `T(operand)` gives the same results as comparing against `operand`.
   template <typename U>
-  static std::string to_string(const U& value) {
-    if constexpr (is_string) {
-      return fmt::format("\"{}\"", value);
-    } else {
-      return fmt::format("{}", value);
+  static bool operand_fits(const U& operand) {
+    return static_cast<U>(static_cast<T>(operand)) == operand;
+  }
+
+  template <typename U, detail::compare_op Op>
+  static size_type compress_with(const comparison<U, Op>& pred, const_pointer in, size_type n, pointer out) {
+#if defined(__AVX2__) || defined(__AVX512F__)
+    return detail::compress_compare<Op, T>(in, n, out, static_cast<T>(pred.operand));
+#else
+    return detail::compress(in, n, out, pred);
+#endif
+  }
+
+  /// @brief Copies the elements whose flag is set, in order, splitting the work into `threads` blocks.
+  array gather(const std::vector<unsigned char>& keep, size_type threads) const {
+    const_pointer in = begin();
+    std::vector<size_type> counts(threads + 1, 0);
+    detail::parallel_for(threads, [&](size_type t) {
+      auto [first, last] = block(t, threads);
+      counts[t + 1] = std::count(keep.begin() + first, keep.begin() + last, 1);
+    });
+    std::partial_sum(counts.begin(), counts.end(), counts.begin());
+    array result(counts.back());
+    detail::parallel_for(threads, [&](size_type t) {
+      auto [first, last] = block(t, threads);
+      pointer out = result.begin() + counts[t];
+      for (size_type i = first; i < last; ++i) {
+        if (keep[i]) *out++ = in[i];
+      }
+    });
+    return result;
+  }
+
+  /// @brief Builds a map from keys to values, calling `update(value, element)` for each element in order.
+  template <typename Key, typename V, typename KeyFn, typename Update>
+  hash_map<Key, V> build_map(KeyFn& key_fn, Update update) const {
+    hash_map<Key, V> result;
+    for (const T& value : *this) {
+      update(result[std::invoke(key_fn, value)], value);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Builds a map from keys to values on several threads.
+   *
+   * The positions are radix-partitioned by the hash of their key and each
+   * thread builds private maps for its partitions, visiting positions in
+   * order. The maps are then merged by first occurrence. `key_fn` is called
+   * twice per element.
+   */
+  template <typename Key, typename V, typename KeyFn, typename Update>
+  hash_map<Key, V> build_map(const parallel_t& policy, KeyFn& key_fn, Update update) const {
+    const_pointer in = begin();
+    size_type threads = detail::thread_count(policy, size(), 1 << 15);
+    if (threads <= 1) return build_map<Key, V>(key_fn, update);
+    auto parts = detail::partition_by_hash(size(), threads, [&](size_type i) { return detail::mix_hash(std::hash<Key> {}(std::invoke(key_fn, in[i]))); });
+    size_type partitions = parts.bounds.size() - 1;
+    std::vector<hash_map<Key, V>> maps(partitions);
+    // firsts[p][j] is the position of the first element with the j-th key of maps[p].
+    std::vector<std::vector<size_type>> firsts(partitions);
+    detail::parallel_for(threads, [&](size_type t) {
+      for (size_type p = t; p < partitions; p += threads) {
+        for (size_type k = parts.bounds[p]; k < parts.bounds[p + 1]; ++k) {
+          size_type i = parts.order[k];
+          size_type before = maps[p].size();
+          V& value = maps[p][std::invoke(key_fn, in[i])];
+          if (maps[p].size() != before) firsts[p].push_back(i);
+          update(value, in[i]);
+        }
+      }
+    });
+
+    struct entry {
+      size_type first, map, index;
+    };
+    std::vector<entry> entries;
+    for (size_type p = 0; p < partitions; ++p) {
+      for (size_type j = 0; j < firsts[p].size(); ++j) {
+        entries.push_back({ firsts[p][j], p, j });
+      }
+    }
+    std::ranges::sort(entries, {}, &entry::first);
+    hash_map<Key, V> result;
+    result.reserve(entries.size());
+    for (const entry& e : entries) {
+      result.insert(maps[e.map].keys()[e.index], std::move(maps[e.map].values()[e.index]));
+    }
+    return result;
+  }
+
+  /// @return The bounds of block `k` when the array is split into `blocks` nearly equal blocks.
+  constexpr std::pair<size_type, size_type> block(size_type k, size_type blocks) const {
+    return { k * size() / blocks, (k + 1) * size() / blocks };
+  }
+
+  /**
+   * @brief Writes the running totals of `[in, in + n)` to `out`, starting from `carry`.
+   *
+   * @param skip The number of leading elements of `in` already folded into `carry`.
+   */
+  template <typename Op>
+  static constexpr void scan_block(const_pointer in, size_type n, pointer out, Op& op, T carry, size_type skip) {
+    if (skip > 0) out[0] = carry;
+    for (size_type i = skip; i < n; ++i) {
+      carry = std::invoke(op, std::move(carry), in[i]);
+      out[i] = carry;
+    }
+  }
+
+  /// @brief Two-pass blocked scan; `initial` is null for an inclusive scan.
+  template <typename Op>
+  void parallel_scan(const parallel_t& policy, pointer out, Op& op, const T* initial) const {
+    const_pointer in = begin();
+    size_type n = size();
+    size_type threads = detail::thread_count(policy, n, 1 << 14);
+    // An exclusive scan is an inclusive scan of the input shifted right by one, led by `initial`.
+    size_type length = initial ? n - 1 : n;
+    if (initial) {
+      out[0] = *initial;
+      ++out;
+    }
+    auto blocks = [&](size_type k) { return std::pair { k * length / threads, (k + 1) * length / threads }; };
+
+    std::vector<T> totals(threads);
+    std::vector<unsigned char> has_total(threads, 0);
+    detail::parallel_for(threads, [&](size_type t) {
+      auto [first, last] = blocks(t);
+      if (first == last) return;
+      T total = in[first];
+      for (size_type i = first + 1; i < last; ++i) {
+        total = std::invoke(op, std::move(total), in[i]);
+      }
+      totals[t] = std::move(total);
+      has_total[t] = 1;
+    });
+
+    // carries[t] folds `initial` and every block before t.
+    std::vector<T> carries(threads);
+    std::vector<unsigned char> has_carry(threads, 0);
+    bool running_set = initial != nullptr;
+    T running = initial ? *initial : T {};
+    for (size_type t = 0; t < threads; ++t) {
+      carries[t] = running;
+      has_carry[t] = running_set;
+      if (has_total[t]) {
+        running = running_set ? std::invoke(op, std::move(running), totals[t]) : totals[t];
+        running_set = true;
+      }
+    }
+
+    detail::parallel_for(threads, [&](size_type t) {
+      auto [first, last] = blocks(t);
+      if (first == last) return;
+      if (has_carry[t]) {
+        scan_block(in + first, last - first, out + first, op, carries[t], 0);
+      } else {
+        scan_block(in + first, last - first, out + first, op, in[first], 1);
+      }
+    });
+  }
+
+  /// @brief Folds `[first, size())` into `accumulator`, passing the index if `f` accepts it.
+  template <typename U, typename F>
+  constexpr U fold(F& f, U accumulator, size_type first) const {
+    const_pointer data = begin();
+    for (size_type i = first; i < size(); ++i) {
+      if constexpr (std::invocable<F&, U, const T&, size_type>) {
+        accumulator = std::invoke(f, std::move(accumulator), data[i], i);
+      } else {
+        accumulator = std::invoke(f, std::move(accumulator), data[i]);
+      }
+    }
+    return accumulator;
+  }
+
+  /// @brief Validates the separator and strips the brackets written by `operator<<`.
+  static std::string_view parse_body(std::string_view text, std::string_view sep) {
+    if (sep.empty()) {
+      throw std::invalid_argument("Separator must not be empty");
+    }
+    text = detail::trim(text);
+    if (text.size() >= 2 && text.front() == '[' && text.back() == ']') {
+      text = detail::trim(text.substr(1, text.size() - 2));
     }
+    return text;
   }
 };
 
@@ -0,0 +1,563 @@
+#ifndef STD_LIB_BIT_ARRAY_H
+#define STD_LIB_BIT_ARRAY_H
+
+#include "array.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+namespace stdlib {
+
+/**
+ * @brief A dynamic array of flags packed 64 per word.
+ *
+ * Offers the JS-style API of `array<bool>` while storing one bit per flag.
+ * Counting, searching and the bitwise operators work a whole word at a time.
+ * Bits past the end of the array are always kept at zero.
+ */
+class bit_array {
+  public:
+  /// @brief The type of the words the flags are packed into.
+  using word_type = std::uint64_t;
+  /// @brief The type of elements stored in the array.
+  using value_type = bool;
+  /// @brief The type of size of the array.
+  using size_type = std::size_t;
+  /// @brief The type of difference between indices.
+  using difference_type = std::ptrdiff_t;
+
+  /// @brief The number of flags stored per word.
+  static constexpr size_type word_bits = 64;
+  /// @brief The value returned by the search functions when no flag is set.
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+  private:
+  /// @brief Pointer to the dynamically allocated words.
+  std::unique_ptr<word_type[]> words_;
+  /// @brief The capacity of the array in words.
+  size_type word_capacity_ = 0;
+  /// @brief The number of flags in the array.
+  size_type size_ = 0;
+
+  public:
+  /**
+   * @brief A proxy reference to a single flag.
+   */
+  class reference {
+    word_type* word_;
+    word_type mask_;
+
+    public:
+    reference(word_type* word, size_type bit) :
+        word_(word), mask_(word_type { 1 } << bit) { }
+
+    /// @return The value of the flag.
+    operator bool() const noexcept { return (*word_ & mask_) != 0; }
+
+    /**
+     * @brief Sets the flag.
+     *
+     * @param value The new value of the flag.
+     * @return Reference to this proxy.
+     */
+    reference& operator=(bool value) noexcept {
+      if (value) {
+        *word_ |= mask_;
+      } else {
+        *word_ &= ~mask_;
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Sets the flag from another flag.
+     *
+     * @param other The flag to copy.
+     * @return Reference to this proxy.
+     */
+    reference& operator=(const reference& other) noexcept {
+      return *this = static_cast<bool>(other);
+    }
+  };
+
+  /// @brief Default constructor.
+  bit_array() = default;
+
+  /**
+   * @brief Constructs an array of `size` flags set to `value`.
+   *
+   * @param size The number of flags.
+   * @param value The value of every flag (default is false).
+   */
+  explicit bit_array(size_type size, bool value = false) :
+      words_(std::make_unique<word_type[]>(words_for(size))), word_capacity_(words_for(size)), size_(size) {
+    if (value) {
+      std::fill_n(words_.get(), word_count(), ~word_type { 0 });
+      clear_tail();
+    }
+  }
+
+  /**
+   * @brief Constructs an array from an initializer list.
+   *
+   * @param list The initializer list to construct the array from.
+   */
+  bit_array(std::initializer_list<bool> list) :
+      bit_array(list.size()) {
+    size_type i = 0;
+    for (bool value : list) {
+      if (value) set_bit(i);
+      ++i;
+    }
+  }
+
+  /**
+   * @brief Constructs an array from an `array<bool>`.
+   *
+   * @param flags The flags to pack.
+   */
+  explicit bit_array(const array<bool>& flags) :
+      bit_array(flags.size()) {
+    for (size_type i = 0; i < flags.size(); ++i) {
+      if (flags[i]) set_bit(i);
+    }
+  }
+
+  /**
+   * @brief Copy constructor.
+   *
+   * @param other The array to copy from.
+   */
+  bit_array(const bit_array& other) :
+      words_(std::make_unique<word_type[]>(other.word_capacity_)),
+      word_capacity_(other.word_capacity_), size_(other.size_) {
+    std::copy_n(other.words_.get(), other.word_count(), words_.get());
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * @param other The array to move from.
+   */
+  bit_array(bit_array&&) noexcept = default;
+
+  /**
+   * @brief Copy assignment operator.
+   *
+   * @param other The array to copy from.
+   * @return Reference to this array.
+   */
+  bit_array& operator=(const bit_array& other) {
+    if (this != &other) {
+      bit_array temp(other);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * @param other The array to move from.
+   * @return Reference to this array.
+   */
+  bit_array& operator=(bit_array&&) noexcept = default;
+
+  /**
+   * @brief Swaps the contents of this array with another array.
+   *
+   * @param other The array to swap with.
+   */
+  void swap(bit_array& other) noexcept {
+    using std::swap;
+    swap(words_, other.words_);
+    swap(word_capacity_, other.word_capacity_);
+    swap(size_, other.size_);
+  }
+
+  /**
+   * @brief Swaps the contents of two arrays.
+   *
+   * @param lhs The first array.
+   * @param rhs The second array.
+   */
+  friend void swap(bit_array& lhs, bit_array& rhs) noexcept { lhs.swap(rhs); }
+
+  /**
+   * @brief Accesses a flag by index.
+   *
+   * @param index The index of the flag.
+   * @return Proxy reference to the flag.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  reference operator[](difference_type index) {
+    check_index(index);
+    return reference(&words_[index / word_bits], index % word_bits);
+  }
+
+  /**
+   * @brief Accesses a flag by index (const version).
+   *
+   * @param index The index of the flag.
+   * @return The value of the flag.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  bool operator[](difference_type index) const {
+    check_index(index);
+    return test_bit(index);
+  }
+
+  /**
+   * @brief Accesses a flag by index with bounds checking.
+   *
+   * @param index The index of the flag.
+   * @return Proxy reference to the flag.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  reference at(difference_type index) { return (*this)[index]; }
+
+  /**
+   * @brief Accesses a flag by index with bounds checking (const version).
+   *
+   * @param index The index of the flag.
+   * @return The value of the flag.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  bool at(difference_type index) const { return (*this)[index]; }
+
+  /**
+   * @brief Compares this array with another array for equality.
+   *
+   * @param other The array to compare with.
+   * @return True if the arrays are equal, false otherwise.
+   */
+  bool operator==(const bit_array& other) const {
+    return size_ == other.size_ && std::equal(words_.get(), words_.get() + word_count(), other.words_.get());
+  }
+
+  /**
+   * @brief Combines two arrays of the same size with a bitwise and.
+   *
+   * @param other The array to combine with.
+   * @return Reference to this array.
+   * @throws std::invalid_argument If the sizes differ.
+   */
+  bit_array& operator&=(const bit_array& other) {
+    check_size(other);
+    for (size_type i = 0; i < word_count(); ++i) {
+      words_[i] &= other.words_[i];
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Combines two arrays of the same size with a bitwise or.
+   *
+   * @param other The array to combine with.
+   * @return Reference to this array.
+   * @throws std::invalid_argument If the sizes differ.
+   */
+  bit_array& operator|=(const bit_array& other) {
+    check_size(other);
+    for (size_type i = 0; i < word_count(); ++i) {
+      words_[i] |= other.words_[i];
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Combines two arrays of the same size with a bitwise exclusive or.
+   *
+   * @param other The array to combine with.
+   * @return Reference to this array.
+   * @throws std::invalid_argument If the sizes differ.
+   */
+  bit_array& operator^=(const bit_array& other) {
+    check_size(other);
+    for (size_type i = 0; i < word_count(); ++i) {
+      words_[i] ^= other.words_[i];
+    }
+    return *this;
+  }
+
+  /// @return A new array with the flags of both arrays combined with a bitwise and.
+  friend bit_array operator&(bit_array lhs, const bit_array& rhs) { return lhs &= rhs; }
+  /// @return A new array with the flags of both arrays combined with a bitwise or.
+  friend bit_array operator|(bit_array lhs, const bit_array& rhs) { return lhs |= rhs; }
+  /// @return A new array with the flags of both arrays combined with a bitwise exclusive or.
+  friend bit_array operator^(bit_array lhs, const bit_array& rhs) { return lhs ^= rhs; }
+
+  /// @return A new array with every flag inverted.
+  bit_array operator~() const {
+    bit_array result(*this);
+    for (size_type i = 0; i < word_count(); ++i) {
+      result.words_[i] = ~result.words_[i];
+    }
+    result.clear_tail();
+    return result;
+  }
+
+  /**
+   * @brief Outputs the array to a stream.
+   *
+   * @param os The output stream.
+   * @param arr The array to output.
+   * @return The output stream.
+   */
+  friend std::ostream& operator<<(std::ostream& os, const bit_array& arr) {
+    os << "[ ";
+    for (size_type i = 0; i < arr.size(); ++i) {
+      if (i > 0) os << ", ";
+      os << arr.test_bit(i);
+    }
+    os << " ]";
+    return os;
+  }
+
+  /**
+   * @brief Adds a flag to the beginning of the array.
+   *
+   * @param value The value to add.
+   */
+  void unshift(bool value) {
+    if (size_ == word_capacity_ * word_bits) {
+      reserve(size_ == 0 ? word_bits : size_ * 2);
+    }
+    ++size_;
+    for (size_type i = word_count(); i-- > 1;) {
+      words_[i] = (words_[i] << 1) | (words_[i - 1] >> (word_bits - 1));
+    }
+    words_[0] = (words_[0] << 1) | word_type { value };
+  }
+
+  /**
+   * @brief Removes and returns the first flag of the array.
+   *
+   * @return The first flag of the array.
+   * @throws std::out_of_range If the array is empty.
+   */
+  bool shift() {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    bool value = test_bit(0);
+    size_type words = word_count();
+    for (size_type i = 0; i + 1 < words; ++i) {
+      words_[i] = (words_[i] >> 1) | (words_[i + 1] << (word_bits - 1));
+    }
+    words_[words - 1] >>= 1;
+    --size_;
+    return value;
+  }
+
+  /**
+   * @brief Adds a flag to the end of the array.
+   *
+   * @param value The value to add.
+   */
+  void push(bool value) {
+    if (size_ == word_capacity_ * word_bits) {
+      reserve(size_ == 0 ? word_bits : size_ * 2);
+    }
+    if (value) set_bit(size_);
+    ++size_;
+  }
+
+  /**
+   * @brief Removes and returns the last flag of the array.
+   *
+   * @return The last flag of the array.
+   * @throws std::out_of_range If the array is empty.
+   */
+  bool pop() {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    bool value = test_bit(--size_);
+    words_[size_ / word_bits] &= ~(word_type { 1 } << (size_ % word_bits));
+    return value;
+  }
+
+  /**
+   * @brief Slices the array.
+   *
+   * @param start The start index.
+   * @param end The end index (default is -1, which means the end of the array).
+   * @return A new array with the sliced flags.
+   */
+  bit_array slice(difference_type start, difference_type end = -1) const {
+    if (end < 0) end += size();
+    start = std::clamp<difference_type>(start, 0, size());
+    end = std::clamp<difference_type>(end, start, size());
+    bit_array result(static_cast<size_type>(end - start));
+    size_type first = start / word_bits;
+    size_type shift = start % word_bits;
+    for (size_type i = 0; i < result.word_count(); ++i) {
+      word_type word = words_[first + i] >> shift;
+      if (shift != 0 && first + i + 1 < word_count()) {
+        word |= words_[first + i + 1] << (word_bits - shift);
+      }
+      result.words_[i] = word;
+    }
+    result.clear_tail();
+    return result;
+  }
+
+  /**
+   * @brief Joins the flags of the array into a string.
+   *
+   * @param sep The separator to use (default is ",").
+   * @return A string with the joined flags.
+   */
+  std::string join(std::string_view sep = ",") const {
+    std::string result;
+    result.reserve(size_ * (5 + sep.size()));
+    for (size_type i = 0; i < size_; ++i) {
+      if (i > 0) result += sep;
+      result += test_bit(i) ? "true" : "false";
+    }
+    return result;
+  }
+
+  /// @return The number of set flags.
+  [[nodiscard]] size_type count() const noexcept {
+    size_type total = 0;
+    for (size_type i = 0; i < word_count(); ++i) {
+      total += std::popcount(words_[i]);
+    }
+    return total;
+  }
+
+  /// @brief Determines if any flag is set.
+  [[nodiscard]] bool any() const noexcept { return find_first() != npos; }
+  /// @brief Determines if no flag is set.
+  [[nodiscard]] bool none() const noexcept { return !any(); }
+  /// @brief Determines if every flag is set.
+  [[nodiscard]] bool all() const noexcept { return count() == size_; }
+
+  /// @return The index of the first set flag, or `npos` if there is none.
+  [[nodiscard]] size_type find_first() const noexcept {
+    return find_from(0);
+  }
+
+  /**
+   * @brief Finds the next set flag after an index.
+   *
+   * @param index The index to search after.
+   * @return The index of the first set flag after `index`, or `npos` if there is none.
+   */
+  [[nodiscard]] size_type find_next(size_type index) const noexcept {
+    // Compare before adding so that `find_next(npos)` does not wrap around to 0.
+    return index >= size_ || index + 1 >= size_ ? npos : find_from(index + 1);
+  }
+
+  /**
+   * @brief Reserves memory for the array.
+   *
+   * @param new_capacity The new capacity of the array in flags.
+   */
+  void reserve(size_type new_capacity) {
+    size_type new_words = words_for(new_capacity);
+    if (new_words > word_capacity_) {
+      auto new_array = std::make_unique<word_type[]>(new_words);
+      std::copy_n(words_.get(), word_count(), new_array.get());
+      words_ = std::move(new_array);
+      word_capacity_ = new_words;
+    }
+  }
+
+  /// @return The packed words of the array; bits past `size()` are zero.
+  [[nodiscard]] std::span<const word_type> words() const noexcept { return { words_.get(), word_count() }; }
+  /// @return The number of flags in the array.
+  [[nodiscard]] size_type size() const noexcept { return size_; }
+  /// @return The capacity of the array in flags.
+  [[nodiscard]] size_type capacity() const noexcept { return word_capacity_ * word_bits; }
+  /// @brief Determines if the array is empty.
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  private:
+  static constexpr size_type words_for(size_type bits) noexcept { return (bits + word_bits - 1) / word_bits; }
+
+  size_type word_count() const noexcept { return words_for(size_); }
+
+  bool test_bit(size_type index) const noexcept {
+    return (words_[index / word_bits] >> (index % word_bits)) & 1;
+  }
+
+  void set_bit(size_type index) noexcept {
+    words_[index / word_bits] |= word_type { 1 } << (index % word_bits);
+  }
+
+  /// @brief Zeroes the bits of the last word that lie past the end of the array.
+  void clear_tail() noexcept {
+    if (size_ % word_bits != 0) {
+      words_[size_ / word_bits] &= (word_type { 1 } << (size_ % word_bits)) - 1;
+    }
+  }
+
+  size_type find_from(size_type index) const noexcept {
+    size_type w = index / word_bits;
+    if (w >= word_count()) return npos;
+    word_type word = words_[w] & (~word_type { 0 } << (index % word_bits));
+    while (word == 0) {
+      if (++w == word_count()) return npos;
+      word = words_[w];
+    }
+    return w * word_bits + std::countr_zero(word);
+  }
+
+  void check_index(difference_type index) const {
+    if (index < 0 || static_cast<size_type>(index) >= size_) {
+      throw std::out_of_range("Index out of bounds");
+    }
+  }
+
+  void check_size(const bit_array& other) const {
+    if (size_ != other.size_) {
+      throw std::invalid_argument("Array sizes differ");
+    }
+  }
+};
+
+/**
+ * @brief Selects the elements of an array whose flag is set in a mask.
+ *
+ * The mask is scanned a word at a time, so runs of unset flags are skipped
+ * without looking at the corresponding elements.
+ *
+ * @tparam T The type of elements stored in the array.
+ * @param values The array to select from.
+ * @param mask The mask with one flag per element.
+ * @return A new array with the selected elements, in order.
+ * @throws std::invalid_argument If the sizes differ.
+ */
+template <typename T>
+array<T> filter_by_mask(const array<T>& values, const bit_array& mask) {
+  if (values.size() != mask.size()) {
+    throw std::invalid_argument("Array sizes differ");
+  }
+  array<T> result(mask.count());
+  auto out = result.begin();
+  auto in = values.begin();
+  auto words = mask.words();
+  for (std::size_t w = 0; w < words.size(); ++w) {
+    for (auto word = words[w]; word != 0; word &= word - 1) {
+      *out++ = in[w * bit_array::word_bits + std::countr_zero(word)];
+    }
+  }
+  return result;
+}
+
+} // namespace stdlib
+
+#endif // STD_LIB_BIT_ARRAY_H
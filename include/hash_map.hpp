@@ -0,0 +1,416 @@
+#ifndef STD_LIB_HASH_MAP_H
+#define STD_LIB_HASH_MAP_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace stdlib {
+
+namespace detail {
+
+/// @brief Scrambles a hash so that its low and high bits are both well distributed.
+constexpr std::uint64_t mix_hash(std::uint64_t hash) noexcept {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/**
+ * @brief An open-addressing table mapping hashes to positions in dense storage.
+ *
+ * Slots are grouped by 16. Each slot has a control byte that is either empty
+ * or holds 7 bits of the hash, so a probe compares a whole group of control
+ * bytes at once (with SSE2 when available) and only looks at the entries
+ * whose bits match. The table only stores positions; callers keep the keys in
+ * insertion order and pass comparison and rehash callbacks.
+ */
+class hash_index {
+  public:
+  /// @brief The value returned by `find` when the key is absent.
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  private:
+  static constexpr std::size_t group_width = 16;
+  static constexpr std::int8_t empty = -128;
+
+  std::unique_ptr<std::int8_t[]> control_;
+  std::unique_ptr<std::size_t[]> slots_;
+  std::size_t capacity_ = 0;
+  std::size_t size_ = 0;
+
+  static std::int8_t fingerprint(std::uint64_t hash) noexcept { return static_cast<std::int8_t>(hash & 0x7F); }
+  static std::size_t home(std::uint64_t hash) noexcept { return static_cast<std::size_t>(hash >> 7); }
+  std::size_t groups() const noexcept { return capacity_ / group_width; }
+
+  /// @return A bit mask of the slots in `group` whose control byte equals `byte`.
+  std::uint32_t match(std::size_t group, std::int8_t byte) const noexcept {
+    const std::int8_t* control = control_.get() + group * group_width;
+#if defined(__SSE2__)
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(byte))));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t lane = 0; lane < group_width; ++lane) {
+      mask |= static_cast<std::uint32_t>(control[lane] == byte) << lane;
+    }
+    return mask;
+#endif
+  }
+
+  /// @brief Stores `index` in the first empty slot of the probe sequence of `hash`.
+  void place(std::uint64_t hash, std::size_t index) noexcept {
+    std::size_t mask = groups() - 1;
+    for (std::size_t group = home(hash) & mask, step = 1;; group = (group + step++) & mask) {
+      if (std::uint32_t free = match(group, empty)) {
+        std::size_t slot = group * group_width + std::countr_zero(free);
+        control_[slot] = fingerprint(hash);
+        slots_[slot] = index;
+        return;
+      }
+    }
+  }
+
+  template <typename HashOf>
+  void rehash(std::size_t new_capacity, HashOf& hash_of) {
+    // Allocate both arrays before giving up the old ones, so a failed allocation leaves the table intact.
+    auto control = std::make_unique_for_overwrite<std::int8_t[]>(new_capacity);
+    auto slots = std::make_unique_for_overwrite<std::size_t[]>(new_capacity);
+    std::fill_n(control.get(), new_capacity, empty);
+    auto old_control = std::exchange(control_, std::move(control));
+    auto old_slots = std::exchange(slots_, std::move(slots));
+    std::size_t old_capacity = std::exchange(capacity_, new_capacity);
+    for (std::size_t slot = 0; slot < old_capacity; ++slot) {
+      if (old_control[slot] != empty) {
+        place(hash_of(old_slots[slot]), old_slots[slot]);
+      }
+    }
+  }
+
+  static std::size_t capacity_for(std::size_t n) noexcept {
+    // Keep the load factor at or below 7/8.
+    return std::max(group_width, std::bit_ceil(n + n / 7 + 1));
+  }
+
+  public:
+  /// @brief Default constructor.
+  hash_index() = default;
+
+  /**
+   * @brief Copy constructor. Duplicates the control bytes and the slots.
+   *
+   * @param other The table to copy from.
+   */
+  hash_index(const hash_index& other) : capacity_(other.capacity_), size_(other.size_) {
+    if (capacity_ > 0) {
+      control_ = std::make_unique_for_overwrite<std::int8_t[]>(capacity_);
+      slots_ = std::make_unique_for_overwrite<std::size_t[]>(capacity_);
+      std::copy_n(other.control_.get(), capacity_, control_.get());
+      std::copy_n(other.slots_.get(), capacity_, slots_.get());
+    }
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * @param other The table to move from.
+   */
+  hash_index(hash_index&& other) noexcept :
+      control_(std::move(other.control_)), slots_(std::move(other.slots_)), capacity_(std::exchange(other.capacity_, 0)),
+      size_(std::exchange(other.size_, 0)) { }
+
+  /**
+   * @brief Copy assignment operator.
+   *
+   * @param other The table to copy from.
+   * @return Reference to this table.
+   */
+  hash_index& operator=(const hash_index& other) {
+    if (this != &other) {
+      hash_index temp(other);
+      *this = std::move(temp);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * @param other The table to move from.
+   * @return Reference to this table.
+   */
+  hash_index& operator=(hash_index&& other) noexcept {
+    control_ = std::move(other.control_);
+    slots_ = std::move(other.slots_);
+    capacity_ = std::exchange(other.capacity_, 0);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+  }
+
+  /**
+   * @brief Finds the position of an entry.
+   *
+   * @param hash The hash of the key.
+   * @param eq Returns true if the entry at a position has the key.
+   * @return The position of the entry, or `npos` if it is absent.
+   */
+  template <typename Eq>
+  std::size_t find(std::uint64_t hash, Eq&& eq) const {
+    if (capacity_ == 0) return npos;
+    std::size_t mask = groups() - 1;
+    for (std::size_t group = home(hash) & mask, step = 1; step <= groups(); group = (group + step++) & mask) {
+      for (std::uint32_t m = match(group, fingerprint(hash)); m != 0; m &= m - 1) {
+        std::size_t slot = group * group_width + std::countr_zero(m);
+        if (eq(slots_[slot])) return slots_[slot];
+      }
+      if (match(group, empty) != 0) return npos;
+    }
+    return npos;
+  }
+
+  /**
+   * @brief Finds an entry, or records `index` as its position if it is absent.
+   *
+   * @param hash The hash of the key.
+   * @param index The position to record for a new entry.
+   * @param eq Returns true if the entry at a position has the key.
+   * @param hash_of Returns the hash of the entry at a position, used when growing.
+   * @return The position of the entry and whether it was inserted.
+   */
+  template <typename Eq, typename HashOf>
+  std::pair<std::size_t, bool> insert(std::uint64_t hash, std::size_t index, Eq&& eq, HashOf&& hash_of) {
+    if ((size_ + 1) * 8 > capacity_ * 7) {
+      rehash(capacity_for(size_ + 1), hash_of);
+    }
+    std::size_t mask = groups() - 1;
+    for (std::size_t group = home(hash) & mask, step = 1;; group = (group + step++) & mask) {
+      for (std::uint32_t m = match(group, fingerprint(hash)); m != 0; m &= m - 1) {
+        std::size_t slot = group * group_width + std::countr_zero(m);
+        if (eq(slots_[slot])) return { slots_[slot], false };
+      }
+      // Entries are never erased, so the first group with a free slot ends the probe.
+      if (std::uint32_t free = match(group, empty)) {
+        std::size_t slot = group * group_width + std::countr_zero(free);
+        control_[slot] = fingerprint(hash);
+        slots_[slot] = index;
+        ++size_;
+        return { index, true };
+      }
+    }
+  }
+
+  /**
+   * @brief Reserves room for `n` entries.
+   *
+   * @param n The number of entries.
+   * @param hash_of Returns the hash of the entry at a position.
+   */
+  template <typename HashOf>
+  void reserve(std::size_t n, HashOf&& hash_of) {
+    if (capacity_for(n) > capacity_) {
+      rehash(capacity_for(n), hash_of);
+    }
+  }
+
+  /// @return The number of entries.
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+};
+
+} // namespace detail
+
+/**
+ * @brief A hash map that keeps its entries in insertion order.
+ *
+ * Keys and values are stored contiguously in the order they were first
+ * inserted, and a `detail::hash_index` maps hashes to their positions, so
+ * lookups probe a flat table and iteration walks plain arrays. Entries cannot
+ * be erased.
+ *
+ * @tparam K The type of keys.
+ * @tparam V The type of values.
+ * @tparam Hash The hash function for keys.
+ * @tparam KeyEqual The equality function for keys.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class hash_map {
+  private:
+  /// @brief The keys, in insertion order.
+  std::vector<K> keys_;
+  /// @brief The values, in the order of their keys.
+  std::vector<V> values_;
+  /// @brief The mixed hashes of the keys, kept to grow the index without rehashing keys.
+  std::vector<std::uint64_t> hashes_;
+  /// @brief The positions of the keys by hash.
+  detail::hash_index index_;
+  [[no_unique_address]] Hash hash_;
+  [[no_unique_address]] KeyEqual equal_;
+
+  public:
+  /// @brief The type of keys.
+  using key_type = K;
+  /// @brief The type of values.
+  using mapped_type = V;
+  /// @brief The type of size of the map.
+  using size_type = std::size_t;
+
+  /// @brief Default constructor.
+  hash_map() = default;
+
+  /**
+   * @brief Accesses the value of a key, inserting a default value if the key is absent.
+   *
+   * @param key The key.
+   * @return Reference to the value.
+   */
+  V& operator[](const K& key) {
+    return values_[emplace(key).first];
+  }
+
+  /**
+   * @brief Accesses the value of a key.
+   *
+   * @param key The key.
+   * @return Reference to the value.
+   * @throws std::out_of_range If the key is absent.
+   */
+  V& at(const K& key) {
+    size_type position = position_of(key);
+    if (position == detail::hash_index::npos) {
+      throw std::out_of_range("Key not found");
+    }
+    return values_[position];
+  }
+
+  /**
+   * @brief Accesses the value of a key (const version).
+   *
+   * @param key The key.
+   * @return Constant reference to the value.
+   * @throws std::out_of_range If the key is absent.
+   */
+  const V& at(const K& key) const {
+    return const_cast<hash_map*>(this)->at(key);
+  }
+
+  /**
+   * @brief Finds the value of a key.
+   *
+   * @param key The key.
+   * @return Pointer to the value, or null if the key is absent.
+   */
+  V* find(const K& key) {
+    size_type position = position_of(key);
+    return position == detail::hash_index::npos ? nullptr : &values_[position];
+  }
+
+  /**
+   * @brief Finds the value of a key (const version).
+   *
+   * @param key The key.
+   * @return Pointer to the value, or null if the key is absent.
+   */
+  const V* find(const K& key) const {
+    return const_cast<hash_map*>(this)->find(key);
+  }
+
+  /**
+   * @brief Determines if the map has a key.
+   *
+   * @param key The key.
+   */
+  [[nodiscard]] bool contains(const K& key) const { return position_of(key) != detail::hash_index::npos; }
+
+  /**
+   * @brief Inserts a key and value if the key is absent.
+   *
+   * @param key The key.
+   * @param value The value.
+   * @return True if the entry was inserted, false if the key was already present.
+   */
+  bool insert(K key, V value) {
+    auto [position, inserted] = emplace(std::move(key));
+    if (inserted) values_[position] = std::move(value);
+    return inserted;
+  }
+
+  /**
+   * @brief Applies a function to each entry, in insertion order.
+   *
+   * @tparam F The type of the function.
+   * @param f The function to apply, called with the key and the value.
+   */
+  template <typename F>
+  void for_each(F&& f) const {
+    for (size_type i = 0; i < size(); ++i) {
+      std::invoke(f, keys_[i], values_[i]);
+    }
+  }
+
+  /**
+   * @brief Reserves memory for the map.
+   *
+   * @param n The number of entries.
+   */
+  void reserve(size_type n) {
+    keys_.reserve(n);
+    values_.reserve(n);
+    hashes_.reserve(n);
+    index_.reserve(n, [this](size_type i) { return hashes_[i]; });
+  }
+
+  /// @return The keys, in insertion order.
+  [[nodiscard]] std::span<const K> keys() const noexcept { return keys_; }
+  /// @return The values, in the order of their keys.
+  [[nodiscard]] std::span<V> values() noexcept { return values_; }
+  /// @return The values, in the order of their keys.
+  [[nodiscard]] std::span<const V> values() const noexcept { return values_; }
+  /// @return The number of entries in the map.
+  [[nodiscard]] size_type size() const noexcept { return keys_.size(); }
+  /// @brief Determines if the map is empty.
+  [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+
+  private:
+  std::uint64_t hash_of(const K& key) const { return detail::mix_hash(hash_(key)); }
+
+  size_type position_of(const K& key) const {
+    return index_.find(hash_of(key), [&](size_type i) { return equal_(keys_[i], key); });
+  }
+
+  /// @return The position of the key and whether it was inserted (with a default value).
+  std::pair<size_type, bool> emplace(K key) {
+    std::uint64_t hash = hash_of(key);
+    size_type position = index_.find(hash, [&](size_type i) { return equal_(keys_[i], key); });
+    if (position != detail::hash_index::npos) return { position, false };
+    // Fill the columns before the index so that it never refers past their end; undo them if anything throws.
+    position = size();
+    keys_.push_back(std::move(key));
+    try {
+      values_.emplace_back();
+      hashes_.push_back(hash);
+      index_.insert(hash, position, [](size_type) { return false; }, [this](size_type i) { return hashes_[i]; });
+    } catch (...) {
+      keys_.pop_back();
+      if (values_.size() > position) values_.pop_back();
+      if (hashes_.size() > position) hashes_.pop_back();
+      throw;
+    }
+    return { position, true };
+  }
+};
+
+} // namespace stdlib
+
+#endif // STD_LIB_HASH_MAP_H
@@ -0,0 +1,437 @@
+#ifndef STD_LIB_INCREMENTAL_ARRAY_H
+#define STD_LIB_INCREMENTAL_ARRAY_H
+
+#include "array.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+namespace stdlib {
+
+/**
+ * @brief A dynamic array whose growth never copies all elements at once.
+ *
+ * When a push finds the array full, a buffer of twice the capacity is
+ * allocated but the elements stay in the old buffer. Every push then moves up
+ * to `migration_step` elements across, and the old buffer is released once it
+ * is empty. Element access never moves elements, so references stay valid
+ * until the next `push`, `pop`, `reserve` or `finish_migration`. Since the next growth is
+ * at least `capacity / 2` pushes away, the migration always finishes first,
+ * so every push is O(1) in the worst case instead of amortized.
+ *
+ * The buffers are allocated uninitialized, so growing does not touch the new
+ * memory either. Until migration completes, an index reads from the new
+ * buffer if it was already moved or was pushed after the growth, and from the
+ * old buffer otherwise. As a consequence, the first write to each page of the
+ * new buffer takes a page fault during some push, which makes the tail latency
+ * (p99.9) worse than that of `array` even though the maximum is much lower.
+ *
+ * @tparam T The type of elements stored in the array.
+ */
+template <typename T>
+class incremental_array {
+  public:
+  /// @brief The type of elements stored in the array.
+  using value_type = T;
+  /// @brief The type of size of the array.
+  using size_type = std::size_t;
+  /// @brief The type of difference between indices.
+  using difference_type = std::ptrdiff_t;
+  /// @brief The type of reference to elements.
+  using reference = T&;
+  /// @brief The type of const reference to elements.
+  using const_reference = const T&;
+
+  /// @brief The number of elements moved to the new buffer by each push or non-const access.
+  static constexpr size_type migration_step = 2;
+
+  private:
+  /// @brief The current buffer.
+  T* array_ = nullptr;
+  /// @brief The capacity of the current buffer.
+  size_type capacity_ = 0;
+  /// @brief The length of the array.
+  size_type length_ = 0;
+  /// @brief The previous buffer while its elements are being moved, or null.
+  T* old_ = nullptr;
+  /// @brief The capacity of the previous buffer.
+  size_type old_capacity_ = 0;
+  /// @brief The number of elements of the array that were in the previous buffer.
+  size_type old_length_ = 0;
+  /// @brief The number of elements already moved from the previous buffer.
+  size_type migrated_ = 0;
+
+  public:
+  /// @brief Default constructor.
+  incremental_array() = default;
+
+  /**
+   * @brief Constructs an array from an initializer list.
+   *
+   * @param list The initializer list to construct the array from.
+   */
+  incremental_array(std::initializer_list<T> list) {
+    reserve(list.size());
+    for (const auto& value : list) {
+      push(value);
+    }
+  }
+
+  /**
+   * @brief Copy constructor.
+   *
+   * @param other The array to copy from.
+   */
+  incremental_array(const incremental_array& other) {
+    reserve(other.size());
+    other.for_each([this](const T& value) { push(value); });
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * @param other The array to move from.
+   */
+  incremental_array(incremental_array&& other) noexcept :
+      array_(std::exchange(other.array_, nullptr)), capacity_(std::exchange(other.capacity_, 0)),
+      length_(std::exchange(other.length_, 0)), old_(std::exchange(other.old_, nullptr)),
+      old_capacity_(std::exchange(other.old_capacity_, 0)), old_length_(std::exchange(other.old_length_, 0)),
+      migrated_(std::exchange(other.migrated_, 0)) { }
+
+  /// @brief Destructor.
+  ~incremental_array() { release(); }
+
+  /**
+   * @brief Copy assignment operator.
+   *
+   * @param other The array to copy from.
+   * @return Reference to this array.
+   */
+  incremental_array& operator=(const incremental_array& other) {
+    if (this != &other) {
+      incremental_array temp(other);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * @param other The array to move from.
+   * @return Reference to this array.
+   */
+  incremental_array& operator=(incremental_array&& other) noexcept {
+    incremental_array temp(std::move(other));
+    swap(temp);
+    return *this;
+  }
+
+  /**
+   * @brief Swaps the contents of this array with another array.
+   *
+   * @param other The array to swap with.
+   */
+  void swap(incremental_array& other) noexcept {
+    using std::swap;
+    swap(array_, other.array_);
+    swap(capacity_, other.capacity_);
+    swap(length_, other.length_);
+    swap(old_, other.old_);
+    swap(old_capacity_, other.old_capacity_);
+    swap(old_length_, other.old_length_);
+    swap(migrated_, other.migrated_);
+  }
+
+  /**
+   * @brief Swaps the contents of two arrays.
+   *
+   * @param lhs The first array.
+   * @param rhs The second array.
+   */
+  friend void swap(incremental_array& lhs, incremental_array& rhs) noexcept { lhs.swap(rhs); }
+
+  /**
+   * @brief Accesses an element by index.
+   *
+   * @param index The index of the element.
+   * @return Reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  reference operator[](difference_type index) {
+    check_index(index);
+    return element(index);
+  }
+
+  /**
+   * @brief Accesses an element by index (const version).
+   *
+   * @param index The index of the element.
+   * @return Constant reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  const_reference operator[](difference_type index) const {
+    check_index(index);
+    return element(index);
+  }
+
+  /**
+   * @brief Accesses an element by index with bounds checking.
+   *
+   * @param index The index of the element.
+   * @return Reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  reference at(difference_type index) { return (*this)[index]; }
+
+  /**
+   * @brief Accesses an element by index with bounds checking (const version).
+   *
+   * @param index The index of the element.
+   * @return Constant reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  const_reference at(difference_type index) const { return (*this)[index]; }
+
+  /**
+   * @brief Compares this array with another array for equality.
+   *
+   * @param other The array to compare with.
+   * @return True if the arrays are equal, false otherwise.
+   */
+  bool operator==(const incremental_array& other) const {
+    if (size() != other.size()) return false;
+    for (size_type i = 0; i < size(); ++i) {
+      if (!(element(i) == other.element(i))) return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Outputs the array to a stream.
+   *
+   * @param os The output stream.
+   * @param arr The array to output.
+   * @return The output stream.
+   */
+  friend std::ostream& operator<<(std::ostream& os, const incremental_array& arr) {
+    os << "[ ";
+    for (size_type i = 0; i < arr.size(); ++i) {
+      if (i > 0) os << ", ";
+      os << arr.element(i);
+    }
+    os << " ]";
+    return os;
+  }
+
+  /**
+   * @brief Adds an element to the end of the array.
+   *
+   * Starts a new migration if the array is full, and moves up to
+   * `migration_step` elements if one is in progress. The new element is
+   * constructed first, so `value` may refer to an element of this array.
+   *
+   * @param value The value to add.
+   */
+  void push(const T& value) {
+    if (length_ == capacity_) {
+      grow(capacity_ == 0 ? 1 : capacity_ * 2);
+    }
+    std::construct_at(array_ + length_, value);
+    ++length_;
+    migrate();
+  }
+
+  /**
+   * @brief Removes and returns the last element of the array.
+   *
+   * @return The last element of the array.
+   * @throws std::out_of_range If the array is empty.
+   */
+  T pop() {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    T* slot = &element(length_ - 1);
+    T value = std::move(*slot);
+    std::destroy_at(slot);
+    --length_;
+    if (old_ && length_ < old_length_) {
+      // The element came from the part of the previous buffer not yet moved.
+      old_length_ = length_;
+      if (migrated_ == old_length_) release_old();
+    }
+    return value;
+  }
+
+  /**
+   * @brief Applies a function to each element of the array.
+   *
+   * @tparam F The type of the function.
+   * @param f The function to apply, called with the value (and its index).
+   */
+  template <typename F>
+  void for_each(F&& f) const {
+    for (size_type i = 0; i < size(); ++i) {
+      if constexpr (std::invocable<F&, const T&, size_type>) {
+        std::invoke(f, element(i), i);
+      } else {
+        std::invoke(f, element(i));
+      }
+    }
+  }
+
+  /**
+   * @brief Reduces the array to a single value using a function.
+   *
+   * @tparam U The type of the result (default is what `f` returns when called with `initial`).
+   * @tparam F The type of the function.
+   * @tparam I The type of the initial value.
+   * @param f The function to use for reducing.
+   * @param initial The initial value.
+   * @return The reduced value.
+   */
+  template <typename U = void, typename F, typename I, typename R = detail::reduce_result_t<U, F, I, T>>
+    requires std::invocable<F&, R, const T&>
+  R reduce(F&& f, I&& initial) const {
+    R accumulator(std::forward<I>(initial));
+    for_each([&](const T& value) { accumulator = std::invoke(f, std::move(accumulator), value); });
+    return accumulator;
+  }
+
+  /**
+   * @brief Joins the elements of the array into a string.
+   *
+   * Strings are quoted, as in `array<std::string>::join`.
+   *
+   * @param sep The separator to use (default is ",").
+   * @return A string with the joined elements.
+   */
+  std::string join(std::string_view sep = ",") const {
+    std::string result;
+    for_each([&](const T& value, size_type i) {
+      if (i > 0) result += sep;
+      result += detail::format_element(value);
+    });
+    return result;
+  }
+
+  /**
+   * @brief Copies the elements into an `array`.
+   *
+   * @return A new array with the elements.
+   */
+  array<T> to_array() const {
+    array<T> result(size());
+    for_each([&](const T& value, size_type i) { result[i] = value; });
+    return result;
+  }
+
+  /**
+   * @brief Reserves memory for the array.
+   *
+   * Like a growth triggered by `push`, this allocates the new buffer and
+   * moves the elements incrementally. A migration still in progress is
+   * completed first, so this is O(n) in that case.
+   *
+   * @param new_capacity The new capacity of the array.
+   */
+  void reserve(size_type new_capacity) {
+    if (new_capacity > capacity_) {
+      grow(new_capacity);
+    }
+  }
+
+  /// @brief Moves every element still in the previous buffer and releases it.
+  void finish_migration() {
+    while (old_) {
+      migrate();
+    }
+  }
+
+  /// @return The the size of the array.
+  [[nodiscard]] size_type size() const noexcept { return length_; }
+  /// @return The capacity of the array.
+  [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+  /// @brief Determines if the array is empty.
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+  /// @brief Determines if elements are still being moved out of the previous buffer.
+  [[nodiscard]] bool migrating() const noexcept { return old_ != nullptr; }
+
+  private:
+  static T* allocate(size_type n) { return std::allocator<T> {}.allocate(n); }
+  static void deallocate(T* buffer, size_type n) noexcept {
+    if (buffer) std::allocator<T> {}.deallocate(buffer, n);
+  }
+
+  bool in_old(size_type index) const noexcept { return old_ && index >= migrated_ && index < old_length_; }
+  T& element(size_type index) noexcept { return in_old(index) ? old_[index] : array_[index]; }
+  const T& element(size_type index) const noexcept { return in_old(index) ? old_[index] : array_[index]; }
+
+  /// @brief Moves up to `migration_step` elements from the previous buffer.
+  void migrate() {
+    if (!old_) return;
+    size_type last = std::min(old_length_, migrated_ + migration_step);
+    for (; migrated_ < last; ++migrated_) {
+      std::construct_at(array_ + migrated_, std::move(old_[migrated_]));
+      std::destroy_at(old_ + migrated_);
+    }
+    if (migrated_ == old_length_) release_old();
+  }
+
+  /// @brief Switches to a new buffer of `new_capacity` elements, leaving the elements in the current one.
+  void grow(size_type new_capacity) {
+    finish_migration();
+    T* buffer = allocate(new_capacity);
+    if (length_ > 0) {
+      old_ = array_;
+      old_capacity_ = capacity_;
+      old_length_ = length_;
+      migrated_ = 0;
+    } else {
+      deallocate(array_, capacity_);
+    }
+    array_ = buffer;
+    capacity_ = new_capacity;
+  }
+
+  void release_old() noexcept {
+    deallocate(old_, old_capacity_);
+    old_ = nullptr;
+    old_capacity_ = 0;
+    old_length_ = 0;
+    migrated_ = 0;
+  }
+
+  void release() noexcept {
+    for (size_type i = 0; i < length_; ++i) {
+      std::destroy_at(&element(i));
+    }
+    release_old();
+    deallocate(array_, capacity_);
+    array_ = nullptr;
+    capacity_ = 0;
+    length_ = 0;
+  }
+
+  void check_index(difference_type index) const {
+    if (index < 0 || static_cast<size_type>(index) >= size()) {
+      throw std::out_of_range("Index out of bounds");
+    }
+  }
+};
+
+} // namespace stdlib
+
+#endif // STD_LIB_INCREMENTAL_ARRAY_H
@@ -0,0 +1,465 @@
+#ifndef STD_LIB_PACKED_ARRAY_H
+#define STD_LIB_PACKED_ARRAY_H
+
+#include "array.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stdlib {
+
+namespace detail {
+
+/// @brief The number of values in a block of a `packed_array`.
+inline constexpr std::size_t pack_block_size = 128;
+
+/**
+ * @brief Unpacks a block of `pack_block_size` values of `W` bits each.
+ *
+ * The width is a template parameter so that every position and shift is a
+ * constant and the loop has no branches, which lets compilers vectorize it
+ * (with per-lane shifts on AVX2, e.g. `-march=native`). The word after the
+ * block is always read, so the payload must be followed by one word.
+ */
+template <unsigned W>
+void unpack(const std::uint64_t* __restrict in, std::uint64_t* __restrict out) noexcept {
+  constexpr std::uint64_t mask = W == 64 ? ~std::uint64_t { 0 } : (std::uint64_t { 1 } << W) - 1;
+  for (std::size_t i = 0; i < pack_block_size; ++i) {
+    if constexpr (W == 0) {
+      out[i] = 0;
+    } else {
+      std::size_t bit = i * W;
+      std::size_t shift = bit % 64;
+      // Shifting twice keeps the shift count below 64 when `shift` is 0.
+      std::uint64_t high = (in[bit / 64 + 1] << 1) << (63 - shift);
+      out[i] = ((in[bit / 64] >> shift) | high) & mask;
+    }
+  }
+}
+
+template <std::size_t... W>
+constexpr auto make_unpackers(std::index_sequence<W...>) {
+  return std::array { &unpack<W>... };
+}
+
+/// @brief `unpackers[w]` unpacks a block of `w`-bit values.
+inline constexpr auto unpackers = make_unpackers(std::make_index_sequence<65> {});
+
+/// @brief Reads value `i` of a block of `width`-bit values.
+inline std::uint64_t extract(const std::uint64_t* in, std::size_t i, unsigned width) noexcept {
+  if (width == 0) return 0;
+  std::uint64_t mask = width == 64 ? ~std::uint64_t { 0 } : (std::uint64_t { 1 } << width) - 1;
+  std::size_t bit = i * width;
+  std::size_t shift = bit % 64;
+  std::uint64_t high = (in[bit / 64 + 1] << 1) << (63 - shift);
+  return ((in[bit / 64] >> shift) | high) & mask;
+}
+
+/// @brief Packs `pack_block_size` values of `width` bits into zeroed words.
+inline void pack(const std::uint64_t* in, std::uint64_t* out, unsigned width) noexcept {
+  if (width == 0) return;
+  for (std::size_t i = 0; i < pack_block_size; ++i) {
+    std::size_t bit = i * width;
+    std::size_t shift = bit % 64;
+    out[bit / 64] |= in[i] << shift;
+    if (shift + width > 64) {
+      out[bit / 64 + 1] |= in[i] >> (64 - shift);
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief A compressed array of integers.
+ *
+ * Values are stored in blocks of 128. Each full block is bit-packed with the
+ * smaller of two encodings:
+ * - frame of reference: each value is stored as its distance from the block
+ *   minimum, using just enough bits for the largest distance;
+ * - delta: each value is stored as its difference from the previous one
+ *   (minus the smallest difference), which suits sorted or slowly changing
+ *   values.
+ *
+ * Values are pushed into an uncompressed tail block, which is packed once it
+ * is full. Indexing reads the block header and then a single value for a
+ * frame-of-reference block. A delta block also stores every
+ * `checkpoint_interval`-th value after its payload, so indexing it sums at
+ * most `checkpoint_interval - 1` differences.
+ * Iteration, `for_each`, `reduce` and `to_array` decode a whole block at a
+ * time.
+ *
+ * @tparam T The type of elements stored in the array.
+ */
+template <std::integral T>
+  requires(!std::same_as<T, bool>)
+class packed_array {
+  public:
+  /// @brief The type of elements stored in the array.
+  using value_type = T;
+  /// @brief The type of size of the array.
+  using size_type = std::size_t;
+  /// @brief The type of difference between iterators.
+  using difference_type = std::ptrdiff_t;
+
+  /// @brief The number of values in a block.
+  static constexpr size_type block_size = detail::pack_block_size;
+  /// @brief The distance between the values of a delta block that are also stored whole.
+  static constexpr size_type checkpoint_interval = 32;
+
+  private:
+  /// @brief The number of checkpoints stored after the payload of a delta block.
+  static constexpr size_type checkpoints = block_size / checkpoint_interval - 1;
+
+  /// @brief The header of a packed block.
+  struct block {
+    /// @brief The block minimum, or the first value of a delta block.
+    std::uint64_t base;
+    /// @brief The smallest difference between consecutive values of a delta block.
+    std::uint64_t step;
+    /// @brief The position of the first payload word of the block.
+    std::size_t offset;
+    /// @brief The number of bits per value.
+    std::uint8_t width;
+    /// @brief Whether the block stores differences.
+    bool delta;
+  };
+
+  /// @brief The headers of the packed blocks.
+  std::vector<block> blocks_;
+  /// @brief The payloads of the packed blocks (each delta block followed by its checkpoints), then one zero word.
+  std::vector<std::uint64_t> words_ = { 0 };
+  /// @brief The values not yet packed.
+  std::array<T, block_size> tail_ {};
+  /// @brief The number of values in the tail.
+  size_type tail_size_ = 0;
+
+  public:
+  /**
+   * @brief An input iterator that decodes one block at a time.
+   *
+   * The iterator holds the decoded block, so dereferencing returns values
+   * rather than references, and copying an iterator copies the block. Post-
+   * increment therefore returns nothing instead of a copy.
+   */
+  class const_iterator {
+    const packed_array* owner_ = nullptr;
+    size_type index_ = 0;
+    std::array<T, block_size> values_ {};
+
+    public:
+    using iterator_category = std::input_iterator_tag;
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = T;
+
+    const_iterator() = default;
+    const_iterator(const packed_array* owner, size_type index) :
+        owner_(owner), index_(index) {
+      if (index_ < owner_->size()) owner_->decode(index_ / block_size, values_.data());
+    }
+
+    reference operator*() const { return values_[index_ % block_size]; }
+
+    const_iterator& operator++() {
+      ++index_;
+      if (index_ % block_size == 0 && index_ < owner_->size()) {
+        owner_->decode(index_ / block_size, values_.data());
+      }
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ == rhs.index_; }
+  };
+
+  /// @brief The type of iterator.
+  using iterator = const_iterator;
+
+  /// @brief Default constructor.
+  packed_array() = default;
+
+  /**
+   * @brief Constructs an array from an initializer list.
+   *
+   * @param list The initializer list to construct the array from.
+   */
+  packed_array(std::initializer_list<T> list) {
+    for (T value : list) {
+      push(value);
+    }
+  }
+
+  /**
+   * @brief Compresses an array.
+   *
+   * @param values The values to compress.
+   */
+  explicit packed_array(const array<T>& values) {
+    blocks_.reserve(values.size() / block_size);
+    for (T value : values) {
+      push(value);
+    }
+  }
+
+  /**
+   * @brief Accesses an element by index.
+   *
+   * In a frame-of-reference block this reads one value. In a delta block it
+   * starts from the nearest checkpoint and sums at most
+   * `checkpoint_interval - 1` differences; read sequential values through the
+   * iterators or `for_each` instead.
+   *
+   * @param index The index of the element.
+   * @return The value of the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  T operator[](difference_type index) const {
+    if (index < 0 || static_cast<size_type>(index) >= size()) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    size_type b = index / block_size;
+    size_type i = index % block_size;
+    if (b == blocks_.size()) return tail_[i];
+    const block& header = blocks_[b];
+    const std::uint64_t* payload = words_.data() + header.offset;
+    if (!header.delta) {
+      return static_cast<T>(header.base + detail::extract(payload, i, header.width));
+    }
+    size_type first = i - i % checkpoint_interval;
+    std::uint64_t value = first == 0 ? header.base : payload[2 * header.width + first / checkpoint_interval - 1];
+    value += (i - first) * header.step;
+    for (size_type k = first + 1; k <= i; ++k) {
+      value += detail::extract(payload, k, header.width);
+    }
+    return static_cast<T>(value);
+  }
+
+  /**
+   * @brief Accesses an element by index with bounds checking.
+   *
+   * @param index The index of the element.
+   * @return The value of the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  T at(difference_type index) const { return (*this)[index]; }
+
+  /**
+   * @brief Compares this array with another array for equality.
+   *
+   * @param other The array to compare with.
+   * @return True if the arrays are equal, false otherwise.
+   */
+  bool operator==(const packed_array& other) const {
+    return size() == other.size() && std::ranges::equal(*this, other);
+  }
+
+  /**
+   * @brief Outputs the array to a stream.
+   *
+   * @param os The output stream.
+   * @param arr The array to output.
+   * @return The output stream.
+   */
+  friend std::ostream& operator<<(std::ostream& os, const packed_array& arr) {
+    os << "[ ";
+    arr.for_each([&](T value, size_type i) {
+      if (i > 0) os << ", ";
+      if constexpr (sizeof(T) == 1) {
+        os << static_cast<int>(value);
+      } else {
+        os << value;
+      }
+    });
+    os << " ]";
+    return os;
+  }
+
+  /**
+   * @brief Adds an element to the end of the array.
+   *
+   * Packs the tail block once it is full.
+   *
+   * @param value The value to add.
+   */
+  void push(T value) {
+    tail_[tail_size_++] = value;
+    if (tail_size_ == block_size) {
+      pack_tail();
+    }
+  }
+
+  /**
+   * @brief Applies a function to each element of the array, decoding a block at a time.
+   *
+   * @tparam F The type of the function.
+   * @param f The function to apply, called with the value (and its index).
+   */
+  template <typename F>
+  void for_each(F&& f) const {
+    std::array<T, block_size> values;
+    for (size_type b = 0; b * block_size < size(); ++b) {
+      size_type count = decode(b, values.data());
+      for (size_type i = 0; i < count; ++i) {
+        if constexpr (std::invocable<F&, T, size_type>) {
+          std::invoke(f, values[i], b * block_size + i);
+        } else {
+          std::invoke(f, values[i]);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Reduces the array to a single value using a function.
+   *
+   * @tparam U The type of the result (default is what `f` returns when called with `initial`).
+   * @tparam F The type of the function.
+   * @tparam I The type of the initial value.
+   * @param f The function, called with the accumulator and the value.
+   * @param initial The initial value.
+   * @return The reduced value.
+   */
+  template <typename U = void, typename F, typename I, typename R = detail::reduce_result_t<U, F, I, T>>
+    requires std::invocable<F&, R, T>
+  R reduce(F&& f, I&& initial) const {
+    R accumulator(std::forward<I>(initial));
+    for_each([&](T value) { accumulator = std::invoke(f, std::move(accumulator), value); });
+    return accumulator;
+  }
+
+  /**
+   * @brief Sums the elements of the array.
+   *
+   * @tparam U The type of the result (default is `T`).
+   * @return The sum of the elements.
+   */
+  template <typename U = T>
+  U sum() const {
+    U total {};
+    std::array<T, block_size> values;
+    for (size_type b = 0; b * block_size < size(); ++b) {
+      size_type count = decode(b, values.data());
+      for (size_type i = 0; i < count; ++i) {
+        total += static_cast<U>(values[i]);
+      }
+    }
+    return total;
+  }
+
+  /**
+   * @brief Decompresses the array.
+   *
+   * @return A new array with the elements.
+   */
+  array<T> to_array() const {
+    array<T> result(size());
+    for (size_type b = 0; b * block_size < size(); ++b) {
+      decode(b, result.begin() + b * block_size);
+    }
+    return result;
+  }
+
+  /// @return The the size of the array.
+  [[nodiscard]] size_type size() const noexcept { return blocks_.size() * block_size + tail_size_; }
+  /// @brief Determines if the array is empty.
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+  /// @return The number of bytes used by the array, including unused reserved memory.
+  [[nodiscard]] size_type memory_usage() const noexcept {
+    return sizeof(*this) + blocks_.capacity() * sizeof(block) + words_.capacity() * sizeof(std::uint64_t);
+  }
+  /// @return An iterator to the beginning of the array.
+  const_iterator begin() const { return { this, 0 }; }
+  /// @return An iterator to the end of the array.
+  const_iterator end() const { return { this, size() }; }
+
+  private:
+  /**
+   * @brief Writes the values of block `b` to `out`.
+   *
+   * @return The number of values written (less than `block_size` only for the tail).
+   */
+  size_type decode(size_type b, T* out) const {
+    if (b == blocks_.size()) {
+      std::copy_n(tail_.begin(), tail_size_, out);
+      return tail_size_;
+    }
+    const block& header = blocks_[b];
+    std::array<std::uint64_t, block_size> packed;
+    detail::unpackers[header.width](words_.data() + header.offset, packed.data());
+    if (header.delta) {
+      std::uint64_t value = header.base;
+      out[0] = static_cast<T>(value);
+      for (size_type i = 1; i < block_size; ++i) {
+        value += header.step + packed[i];
+        out[i] = static_cast<T>(value);
+      }
+    } else {
+      for (size_type i = 0; i < block_size; ++i) {
+        out[i] = static_cast<T>(header.base + packed[i]);
+      }
+    }
+    return block_size;
+  }
+
+  /// @brief Packs the full tail with the narrower of the two encodings.
+  void pack_tail() {
+    if (words_.empty()) words_.push_back(0); // moved-from
+    // Converting to 64 bits sign-extends; wrapping arithmetic then keeps both encodings exact.
+    std::array<std::uint64_t, block_size> values;
+    std::ranges::transform(tail_, values.begin(), [](T value) { return static_cast<std::uint64_t>(value); });
+
+    auto [low, high] = std::ranges::minmax(tail_);
+    std::uint64_t base = static_cast<std::uint64_t>(low);
+    unsigned for_width = std::bit_width(static_cast<std::uint64_t>(high) - base);
+
+    std::int64_t min_step = static_cast<std::int64_t>(values[1] - values[0]);
+    std::int64_t max_step = min_step;
+    for (size_type i = 2; i < block_size; ++i) {
+      std::int64_t step = static_cast<std::int64_t>(values[i] - values[i - 1]);
+      min_step = std::min(min_step, step);
+      max_step = std::max(max_step, step);
+    }
+    unsigned delta_width = std::bit_width(static_cast<std::uint64_t>(max_step) - static_cast<std::uint64_t>(min_step));
+
+    block header { base, 0, words_.size() - 1, static_cast<std::uint8_t>(for_width), false };
+    std::array<std::uint64_t, block_size> packed;
+    // Compare sizes in words: a delta block also stores its checkpoints.
+    if (2 * delta_width + checkpoints < 2 * for_width) {
+      header = { values[0], static_cast<std::uint64_t>(min_step), header.offset, static_cast<std::uint8_t>(delta_width), true };
+      packed[0] = 0;
+      for (size_type i = 1; i < block_size; ++i) {
+        packed[i] = values[i] - values[i - 1] - header.step;
+      }
+    } else {
+      for (size_type i = 0; i < block_size; ++i) {
+        packed[i] = values[i] - base;
+      }
+    }
+    // A block of w-bit values takes 2w words (plus the checkpoints of a delta block); the trailing zero word moves after it.
+    words_.resize(words_.size() + 2 * header.width + (header.delta ? checkpoints : 0), 0);
+    detail::pack(packed.data(), words_.data() + header.offset, header.width);
+    if (header.delta) {
+      for (size_type c = 1; c <= checkpoints; ++c) {
+        words_[header.offset + 2 * header.width + c - 1] = values[c * checkpoint_interval];
+      }
+    }
+    blocks_.push_back(header);
+    tail_size_ = 0;
+  }
+};
+
+} // namespace stdlib
+
+#endif // STD_LIB_PACKED_ARRAY_H
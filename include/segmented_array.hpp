@@ -0,0 +1,572 @@
+#ifndef STD_LIB_SEGMENTED_ARRAY_H
+#define STD_LIB_SEGMENTED_ARRAY_H
+
+#include "array.hpp"
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+namespace stdlib {
+
+/**
+ * @brief A dynamic array stored in fixed-size chunks.
+ *
+ * Growing the array allocates one more chunk and never moves the existing
+ * elements, so peak memory during growth is the size of the array plus one
+ * chunk, no push pays for a full copy, and references to elements stay valid
+ * until the element is removed. Elements are reached through a small index of
+ * chunk pointers, which keeps indexing and iterators random-access.
+ *
+ * @tparam T The type of elements stored in the array.
+ * @tparam ChunkSize The number of elements per chunk; must be a power of two.
+ */
+template <typename T, std::size_t ChunkSize = 4096>
+class segmented_array {
+  static_assert(ChunkSize > 0 && std::has_single_bit(ChunkSize), "ChunkSize must be a power of two");
+
+  private:
+  /// @brief The chunks, in order; only the first and last may be partially used.
+  std::vector<std::unique_ptr<T[]>> chunks_;
+  /// @brief The position of the first element in the first chunk.
+  std::size_t head_ = 0;
+  /// @brief The length of the array.
+  std::size_t length_ = 0;
+
+  public:
+  /// @brief The type of elements stored in the array.
+  using value_type = T;
+  /// @brief The type of size of the array.
+  using size_type = std::size_t;
+  /// @brief The type of difference between iterators.
+  using difference_type = std::ptrdiff_t;
+  /// @brief The type of reference to elements.
+  using reference = T&;
+  /// @brief The type of const reference to elements.
+  using const_reference = const T&;
+
+  /// @brief The number of elements per chunk.
+  static constexpr size_type chunk_size = ChunkSize;
+
+  /**
+   * @brief A random-access iterator over the elements.
+   *
+   * @tparam Const Whether the iterator refers to a const array.
+   */
+  template <bool Const>
+  class basic_iterator {
+    using owner_type = std::conditional_t<Const, const segmented_array, segmented_array>;
+    owner_type* owner_ = nullptr;
+    size_type index_ = 0;
+
+    public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    basic_iterator() = default;
+    basic_iterator(owner_type* owner, size_type index) :
+        owner_(owner), index_(index) { }
+    /// @brief Converts an iterator to a const iterator.
+    operator basic_iterator<true>() const
+      requires(!Const)
+    {
+      return { owner_, index_ };
+    }
+
+    reference operator*() const { return owner_->element(index_); }
+    pointer operator->() const { return &owner_->element(index_); }
+    reference operator[](difference_type n) const { return owner_->element(index_ + n); }
+
+    basic_iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      auto copy = *this;
+      ++index_;
+      return copy;
+    }
+    basic_iterator& operator--() {
+      --index_;
+      return *this;
+    }
+    basic_iterator operator--(int) {
+      auto copy = *this;
+      --index_;
+      return copy;
+    }
+    basic_iterator& operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    basic_iterator& operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+    friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+    friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+    friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs) {
+      return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+    friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.index_ == rhs.index_; }
+    friend auto operator<=>(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.index_ <=> rhs.index_; }
+  };
+
+  /// @brief The type of iterator.
+  using iterator = basic_iterator<false>;
+  /// @brief The type of const iterator.
+  using const_iterator = basic_iterator<true>;
+
+  /// @brief Default constructor.
+  segmented_array() = default;
+
+  /**
+   * @brief Constructs an array from an initializer list.
+   *
+   * @param list The initializer list to construct the array from.
+   */
+  segmented_array(std::initializer_list<T> list) {
+    reserve(list.size());
+    for (const auto& value : list) {
+      push(value);
+    }
+  }
+
+  /**
+   * @brief Copy constructor.
+   *
+   * @param other The array to copy from.
+   */
+  segmented_array(const segmented_array& other) :
+      head_(other.head_), length_(other.length_) {
+    chunks_.reserve(other.chunks_.size());
+    for (const auto& chunk : other.chunks_) {
+      chunks_.push_back(std::make_unique<T[]>(ChunkSize));
+      std::copy_n(chunk.get(), ChunkSize, chunks_.back().get());
+    }
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * @param other The array to move from.
+   */
+  segmented_array(segmented_array&& other) noexcept :
+      chunks_(std::move(other.chunks_)), head_(std::exchange(other.head_, 0)), length_(std::exchange(other.length_, 0)) { }
+
+  /**
+   * @brief Copy assignment operator.
+   *
+   * @param other The array to copy from.
+   * @return Reference to this array.
+   */
+  segmented_array& operator=(const segmented_array& other) {
+    if (this != &other) {
+      segmented_array temp(other);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * @param other The array to move from.
+   * @return Reference to this array.
+   */
+  segmented_array& operator=(segmented_array&& other) noexcept {
+    segmented_array temp(std::move(other));
+    swap(temp);
+    return *this;
+  }
+
+  /**
+   * @brief Swaps the contents of this array with another array.
+   *
+   * @param other The array to swap with.
+   */
+  void swap(segmented_array& other) noexcept {
+    using std::swap;
+    swap(chunks_, other.chunks_);
+    swap(head_, other.head_);
+    swap(length_, other.length_);
+  }
+
+  /**
+   * @brief Swaps the contents of two arrays.
+   *
+   * @param lhs The first array.
+   * @param rhs The second array.
+   */
+  friend void swap(segmented_array& lhs, segmented_array& rhs) noexcept { lhs.swap(rhs); }
+
+  /**
+   * @brief Accesses an element by index.
+   *
+   * @param index The index of the element.
+   * @return Reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  reference operator[](difference_type index) {
+    check_index(index);
+    return element(index);
+  }
+
+  /**
+   * @brief Accesses an element by index (const version).
+   *
+   * @param index The index of the element.
+   * @return Constant reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  const_reference operator[](difference_type index) const {
+    check_index(index);
+    return element(index);
+  }
+
+  /**
+   * @brief Accesses an element by index with bounds checking.
+   *
+   * @param index The index of the element.
+   * @return Reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  reference at(difference_type index) { return (*this)[index]; }
+
+  /**
+   * @brief Accesses an element by index with bounds checking (const version).
+   *
+   * @param index The index of the element.
+   * @return Constant reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  const_reference at(difference_type index) const { return (*this)[index]; }
+
+  /**
+   * @brief Compares this array with another array for equality.
+   *
+   * @param other The array to compare with.
+   * @return True if the arrays are equal, false otherwise.
+   */
+  bool operator==(const segmented_array& other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+  }
+
+  /**
+   * @brief Outputs the array to a stream.
+   *
+   * @param os The output stream.
+   * @param arr The array to output.
+   * @return The output stream.
+   */
+  friend std::ostream& operator<<(std::ostream& os, const segmented_array& arr) {
+    os << "[ ";
+    for (size_type i = 0; i < arr.size(); ++i) {
+      if (i > 0) os << ", ";
+      os << arr.element(i);
+    }
+    os << " ]";
+    return os;
+  }
+
+  /**
+   * @brief Adds an element to the beginning of the array.
+   *
+   * Allocates a new first chunk when the first chunk has no room in front;
+   * existing elements are not moved.
+   *
+   * @param value The value to add.
+   */
+  void unshift(const T& value) {
+    if (head_ == 0) {
+      chunks_.insert(chunks_.begin(), std::make_unique<T[]>(ChunkSize));
+      head_ = ChunkSize;
+    }
+    --head_;
+    ++length_;
+    element(0) = value;
+  }
+
+  /**
+   * @brief Removes and returns the first element of the array.
+   *
+   * @return The first element of the array.
+   * @throws std::out_of_range If the array is empty.
+   */
+  T shift() {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    T value = std::move(element(0));
+    ++head_;
+    --length_;
+    if (head_ == ChunkSize) {
+      chunks_.erase(chunks_.begin());
+      head_ = 0;
+    }
+    return value;
+  }
+
+  /**
+   * @brief Adds an element to the end of the array.
+   *
+   * Allocates a new last chunk when the last chunk is full; existing elements
+   * are not moved.
+   *
+   * @param value The value to add.
+   */
+  void push(const T& value) {
+    if (head_ + length_ == capacity_slots()) {
+      chunks_.push_back(std::make_unique<T[]>(ChunkSize));
+    }
+    ++length_;
+    element(length_ - 1) = value;
+  }
+
+  /**
+   * @brief Removes and returns the last element of the array.
+   *
+   * @return The last element of the array.
+   * @throws std::out_of_range If the array is empty.
+   */
+  T pop() {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    T value = std::move(element(length_ - 1));
+    --length_;
+    // Release the last chunk once it is empty.
+    if (head_ + length_ <= capacity_slots() - ChunkSize) {
+      chunks_.pop_back();
+      if (chunks_.empty()) head_ = 0;
+    }
+    return value;
+  }
+
+  /**
+   * @brief Applies a function to each element of the array.
+   *
+   * @tparam F The type of the function.
+   * @param f The function to apply, called with the value (and its index).
+   */
+  template <typename F>
+  void for_each(F&& f) const {
+    size_type i = 0;
+    for_each_chunk(*this, [&](const T* data, size_type count) {
+      for (size_type k = 0; k < count; ++k) {
+        if constexpr (std::invocable<F&, const T&, size_type>) {
+          std::invoke(f, data[k], i++);
+        } else {
+          std::invoke(f, data[k]);
+        }
+      }
+    });
+  }
+
+  /**
+   * @brief Maps the array using a function.
+   *
+   * @tparam F The type of the function.
+   * @param f The function to use for mapping.
+   * @return A new array with the mapped elements.
+   */
+  template <std::invocable<const T&> F>
+  auto map(F&& f) const -> segmented_array<std::remove_cvref_t<std::invoke_result_t<F&, const T&>>, ChunkSize> {
+    segmented_array<std::remove_cvref_t<std::invoke_result_t<F&, const T&>>, ChunkSize> result;
+    result.reserve(size());
+    for_each([&](const T& value) { result.push(std::invoke(f, value)); });
+    return result;
+  }
+
+  /**
+   * @brief Filters the array using a predicate.
+   *
+   * @tparam Pred The type of the predicate.
+   * @param pred The predicate to use for filtering.
+   * @return A new array with the elements that satisfy the predicate.
+   */
+  template <std::invocable<const T&> Pred>
+  segmented_array filter(Pred&& pred) const {
+    segmented_array result;
+    for_each([&](const T& value) {
+      if (std::invoke(pred, value)) result.push(value);
+    });
+    return result;
+  }
+
+  /**
+   * @brief Reduces the array to a single value using a function.
+   *
+   * @tparam U The type of the result (default is what `f` returns when called with `initial`).
+   * @tparam F The type of the function.
+   * @tparam I The type of the initial value.
+   * @param f The function to use for reducing.
+   * @param initial The initial value.
+   * @return The reduced value.
+   */
+  template <typename U = void, typename F, typename I, typename R = detail::reduce_result_t<U, F, I, T>>
+    requires std::invocable<F&, R, const T&>
+  R reduce(F&& f, I&& initial) const {
+    R accumulator(std::forward<I>(initial));
+    for_each([&](const T& value) { accumulator = std::invoke(f, std::move(accumulator), value); });
+    return accumulator;
+  }
+
+  /**
+   * @brief Slices the array.
+   *
+   * @param start The start index.
+   * @param end The end index (default is -1, which means the end of the array).
+   * @return A new array with the sliced elements.
+   */
+  segmented_array slice(difference_type start, difference_type end = -1) const {
+    if (end < 0) end += size();
+    start = std::clamp<difference_type>(start, 0, size());
+    end = std::clamp<difference_type>(end, start, size());
+    segmented_array result;
+    result.reserve(end - start);
+    for (auto i = start; i < end; ++i) {
+      result.push(element(i));
+    }
+    return result;
+  }
+
+  /**
+   * @brief Joins the elements of the array into a string.
+   *
+   * Strings are quoted, as in `array<std::string>::join`.
+   *
+   * @param sep The separator to use (default is ",").
+   * @return A string with the joined elements.
+   */
+  std::string join(std::string_view sep = ",") const {
+    std::string result;
+    for_each([&](const T& value, size_type i) {
+      if (i > 0) result += sep;
+      result += detail::format_element(value);
+    });
+    return result;
+  }
+
+  /**
+   * @brief Returns the used part of every chunk, in order.
+   *
+   * Bulk kernels can run over each span as contiguous memory.
+   *
+   * @return One span per non-empty chunk.
+   */
+  std::vector<std::span<T>> chunks() {
+    std::vector<std::span<T>> result;
+    for_each_chunk(*this, [&](T* data, size_type count) { result.emplace_back(data, count); });
+    return result;
+  }
+
+  /**
+   * @brief Returns the used part of every chunk, in order (const version).
+   *
+   * @return One span per non-empty chunk.
+   */
+  std::vector<std::span<const T>> chunks() const {
+    std::vector<std::span<const T>> result;
+    for_each_chunk(*this, [&](const T* data, size_type count) { result.emplace_back(data, count); });
+    return result;
+  }
+
+  /**
+   * @brief Copies the elements into a single contiguous array.
+   *
+   * @return A new array with the elements.
+   */
+  array<T> to_contiguous() const {
+    array<T> result(size());
+    auto out = result.begin();
+    for_each_chunk(*this, [&](const T* data, size_type count) { out = std::copy_n(data, count, out); });
+    return result;
+  }
+
+  /**
+   * @brief Reserves memory for the array.
+   *
+   * @param new_capacity The new capacity of the array.
+   */
+  void reserve(size_type new_capacity) {
+    while (capacity() < new_capacity) {
+      chunks_.push_back(std::make_unique<T[]>(ChunkSize));
+    }
+  }
+
+  /// @return The the size of the array.
+  [[nodiscard]] size_type size() const noexcept { return length_; }
+  /// @return The number of elements the array can hold without allocating a chunk at the end.
+  [[nodiscard]] size_type capacity() const noexcept { return capacity_slots() - head_; }
+  /// @brief Determines if the array is empty.
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+  /// @return An iterator to the beginning of the array.
+  iterator begin() noexcept { return { this, 0 }; }
+  /// @return A const iterator to the beginning of the array.
+  const_iterator begin() const noexcept { return { this, 0 }; }
+  /// @return An iterator to the end of the array.
+  iterator end() noexcept { return { this, length_ }; }
+  /// @return A const iterator to the end of the array.
+  const_iterator end() const noexcept { return { this, length_ }; }
+
+  private:
+  size_type capacity_slots() const noexcept { return chunks_.size() * ChunkSize; }
+
+  T& element(size_type index) noexcept {
+    size_type position = head_ + index;
+    return chunks_[position / ChunkSize][position % ChunkSize];
+  }
+
+  const T& element(size_type index) const noexcept {
+    size_type position = head_ + index;
+    return chunks_[position / ChunkSize][position % ChunkSize];
+  }
+
+  /// @brief Calls `f(data, count)` for the used part of every chunk, in order.
+  template <typename Self, typename F>
+  static void for_each_chunk(Self& self, F&& f) {
+    size_type position = self.head_;
+    size_type remaining = self.length_;
+    for (size_type c = 0; remaining > 0; ++c) {
+      size_type offset = position % ChunkSize;
+      size_type count = std::min(ChunkSize - offset, remaining);
+      f(self.chunks_[c].get() + offset, count);
+      position += count;
+      remaining -= count;
+    }
+  }
+
+  void check_index(difference_type index) const {
+    if (index < 0 || static_cast<size_type>(index) >= size()) {
+      throw std::out_of_range("Index out of bounds");
+    }
+  }
+
+  template <typename U, std::size_t N>
+  friend class segmented_array;
+};
+
+} // namespace stdlib
+
+#endif // STD_LIB_SEGMENTED_ARRAY_H
@@ -0,0 +1,418 @@
+#ifndef STD_LIB_SOA_ARRAY_H
+#define STD_LIB_SOA_ARRAY_H
+
+#include "array.hpp"
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace stdlib {
+
+/**
+ * @brief A structure-of-arrays container for record types.
+ *
+ * Each listed data member of `T` is stored in its own contiguous column, so
+ * an operation that reads a single field only touches that field's memory.
+ * Rows are exposed through proxy references that read from and write to the
+ * columns.
+ *
+ * @code
+ * struct event { long ts; double value; int kind; };
+ * soa_array<event, &event::ts, &event::value, &event::kind> events;
+ * events.push({ 1, 2.5, 0 });
+ * double total = events.reduce<&event::value>([](double a, double b) { return a + b; }, 0.0);
+ * @endcode
+ *
+ * @tparam T The record type. It must be default constructible.
+ * @tparam Members Pointers to the data members of `T` that are stored.
+ */
+template <typename T, auto... Members>
+class soa_array {
+  static_assert(sizeof...(Members) > 0, "soa_array requires at least one member");
+  static_assert((std::is_member_object_pointer_v<decltype(Members)> && ...), "soa_array members must be pointers to data members");
+  static_assert(std::is_default_constructible_v<T>, "soa_array requires a default constructible record type");
+
+  public:
+  /// @brief The type of a column storing the data member `Member`.
+  template <auto Member>
+  using member_type = std::remove_cvref_t<decltype(std::declval<T&>().*Member)>;
+  /// @brief The type of the record stored in each row.
+  using value_type = T;
+  /// @brief The type of size of the array.
+  using size_type = std::size_t;
+  /// @brief The type of difference between indices.
+  using difference_type = std::ptrdiff_t;
+
+  private:
+  using columns_type = std::tuple<array<member_type<Members>>...>;
+  using index_sequence = std::index_sequence_for<decltype(Members)...>;
+
+  /// @brief One contiguous column per member.
+  columns_type columns_;
+
+  template <auto A, auto B>
+  static constexpr bool same_member() {
+    if constexpr (std::is_same_v<decltype(A), decltype(B)>) {
+      return A == B;
+    } else {
+      return false;
+    }
+  }
+
+  template <auto Member>
+  static constexpr std::size_t index_of() {
+    constexpr bool matches[] = { same_member<Member, Members>()... };
+    for (std::size_t i = 0; i < sizeof...(Members); ++i) {
+      if (matches[i]) return i;
+    }
+    return sizeof...(Members);
+  }
+
+  template <auto Member>
+  static constexpr std::size_t column_index = index_of<Member>();
+
+  static constexpr auto members = std::make_tuple(Members...);
+
+  /**
+   * @brief A proxy reference to a single row.
+   *
+   * @tparam Const Whether the proxy refers to a const array.
+   */
+  template <bool Const>
+  class basic_reference {
+    using owner_type = std::conditional_t<Const, const soa_array, soa_array>;
+    owner_type* owner_;
+    size_type index_;
+
+    public:
+    basic_reference(owner_type* owner, size_type index) :
+        owner_(owner), index_(index) { }
+
+    /**
+     * @brief Accesses a single field of the row.
+     *
+     * @tparam Member The data member to access.
+     * @return Reference to the field inside its column.
+     */
+    template <auto Member>
+    decltype(auto) get() const {
+      return std::get<column_index<Member>>(owner_->columns_)[index_];
+    }
+
+    /// @return A copy of the row assembled from its columns.
+    operator T() const {
+      return owner_->load(index_, index_sequence {});
+    }
+
+    /**
+     * @brief Writes a record into the row.
+     *
+     * @param value The record to scatter into the columns.
+     * @return Reference to this proxy.
+     */
+    const basic_reference& operator=(const T& value) const
+      requires(!Const)
+    {
+      owner_->store(index_, value, index_sequence {});
+      return *this;
+    }
+  };
+
+  template <std::size_t... I>
+  T load(size_type index, std::index_sequence<I...>) const {
+    T value {};
+    ((value.*std::get<I>(members) = std::get<I>(columns_)[index]), ...);
+    return value;
+  }
+
+  template <std::size_t... I>
+  void store(size_type index, const T& value, std::index_sequence<I...>) {
+    ((std::get<I>(columns_)[index] = value.*std::get<I>(members)), ...);
+  }
+
+  template <std::size_t... I>
+  void push_row(const T& value, std::index_sequence<I...>) {
+    (std::get<I>(columns_).push(value.*std::get<I>(members)), ...);
+  }
+
+  template <std::size_t... I>
+  T pop_row(std::index_sequence<I...>) {
+    T value {};
+    ((value.*std::get<I>(members) = std::get<I>(columns_).pop()), ...);
+    return value;
+  }
+
+  template <std::size_t... I>
+  void unshift_row(const T& value, std::index_sequence<I...>) {
+    (std::get<I>(columns_).unshift(value.*std::get<I>(members)), ...);
+  }
+
+  template <std::size_t... I>
+  T shift_row(std::index_sequence<I...>) {
+    T value {};
+    ((value.*std::get<I>(members) = std::get<I>(columns_).shift()), ...);
+    return value;
+  }
+
+  public:
+  /// @brief The type of proxy reference to a row.
+  using reference = basic_reference<false>;
+  /// @brief The type of const proxy reference to a row.
+  using const_reference = basic_reference<true>;
+
+  /// @brief Default constructor.
+  soa_array() = default;
+
+  /**
+   * @brief Constructs an array from an initializer list of records.
+   *
+   * @param list The initializer list to construct the array from.
+   */
+  soa_array(std::initializer_list<T> list) {
+    reserve(list.size());
+    for (const auto& value : list) {
+      push(value);
+    }
+  }
+
+  /**
+   * @brief Accesses a row by index.
+   *
+   * @param index The index of the row.
+   * @return Proxy reference to the row.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  reference operator[](difference_type index) {
+    check_index(index);
+    return reference(this, static_cast<size_type>(index));
+  }
+
+  /**
+   * @brief Accesses a row by index (const version).
+   *
+   * @param index The index of the row.
+   * @return Const proxy reference to the row.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  const_reference operator[](difference_type index) const {
+    check_index(index);
+    return const_reference(this, static_cast<size_type>(index));
+  }
+
+  /**
+   * @brief Accesses a row by index with bounds checking.
+   *
+   * @param index The index of the row.
+   * @return Proxy reference to the row.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  reference at(difference_type index) { return (*this)[index]; }
+
+  /**
+   * @brief Accesses a row by index with bounds checking (const version).
+   *
+   * @param index The index of the row.
+   * @return Const proxy reference to the row.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  const_reference at(difference_type index) const { return (*this)[index]; }
+
+  /**
+   * @brief Adds a record to the end of the array.
+   *
+   * @param value The record to add.
+   */
+  void push(const T& value) { push_row(value, index_sequence {}); }
+
+  /**
+   * @brief Removes and returns the last record of the array.
+   *
+   * @return The last record of the array.
+   * @throws std::out_of_range If the array is empty.
+   */
+  T pop() {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    return pop_row(index_sequence {});
+  }
+
+  /**
+   * @brief Adds a record to the beginning of the array.
+   *
+   * @param value The record to add.
+   */
+  void unshift(const T& value) { unshift_row(value, index_sequence {}); }
+
+  /**
+   * @brief Removes and returns the first record of the array.
+   *
+   * @return The first record of the array.
+   * @throws std::out_of_range If the array is empty.
+   */
+  T shift() {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    return shift_row(index_sequence {});
+  }
+
+  /**
+   * @brief Slices the array.
+   *
+   * @param start The start index.
+   * @param end The end index (default is -1, which means the end of the array).
+   * @return A new array with the sliced rows.
+   */
+  soa_array slice(difference_type start, difference_type end = -1) const {
+    soa_array result;
+    std::apply([&](auto&... out) {
+      std::apply([&](const auto&... in) {
+        ((out = in.slice(start, end)), ...);
+      },
+        columns_);
+    },
+      result.columns_);
+    return result;
+  }
+
+  /**
+   * @brief Returns the column storing a data member.
+   *
+   * The column is a regular `array`, so its functional API (map, filter,
+   * reduce, ...) runs over contiguous memory of a single field.
+   *
+   * @tparam Member The data member whose column is returned.
+   * @return Constant reference to the column.
+   */
+  template <auto Member>
+  const array<member_type<Member>>& column() const {
+    static_assert(column_index<Member> < sizeof...(Members), "Member is not stored in this soa_array");
+    return std::get<column_index<Member>>(columns_);
+  }
+
+  /**
+   * @brief Returns a mutable view over the column storing a data member.
+   *
+   * @tparam Member The data member whose column is returned.
+   * @return A span over the column.
+   */
+  template <auto Member>
+  std::span<member_type<Member>> span() {
+    static_assert(column_index<Member> < sizeof...(Members), "Member is not stored in this soa_array");
+    auto& col = std::get<column_index<Member>>(columns_);
+    return { col.begin(), col.size() };
+  }
+
+  /**
+   * @brief Returns a view over the column storing a data member (const version).
+   *
+   * @tparam Member The data member whose column is returned.
+   * @return A span over the column.
+   */
+  template <auto Member>
+  std::span<const member_type<Member>> span() const {
+    const auto& col = column<Member>();
+    return { col.begin(), col.size() };
+  }
+
+  /**
+   * @brief Maps a single column using a function.
+   *
+   * @tparam Member The data member to map.
+   * @tparam F The type of the function.
+   * @param f The function to use for mapping.
+   * @return A new array with the mapped values.
+   */
+  template <auto Member, typename F>
+  auto map(F&& f) const {
+    return column<Member>().map(std::forward<F>(f));
+  }
+
+  /**
+   * @brief Reduces a single column to a value using a function.
+   *
+   * @tparam Member The data member to reduce.
+   * @tparam U The type of the result (default is what `f` returns when called with `initial`).
+   * @tparam F The type of the function.
+   * @tparam I The type of the initial value.
+   * @param f The function to use for reducing.
+   * @param initial The initial value.
+   * @return The reduced value.
+   */
+  template <auto Member, typename U = void, typename F, typename I>
+  auto reduce(F&& f, I&& initial) const {
+    return column<Member>().template reduce<U>(std::forward<F>(f), std::forward<I>(initial));
+  }
+
+  /**
+   * @brief Filters the rows using a predicate on a single column.
+   *
+   * Only the tested column is read while evaluating the predicate; the other
+   * columns are gathered once for the selected rows.
+   *
+   * @tparam Member The data member tested by the predicate.
+   * @tparam Pred The type of the predicate.
+   * @param pred The predicate to use for filtering.
+   * @return A new array with the rows whose field satisfies the predicate.
+   */
+  template <auto Member, typename Pred>
+  soa_array filter(Pred&& pred) const {
+    const auto& tested = column<Member>();
+    array<size_type> selected;
+    selected.reserve(tested.size());
+    for (size_type i = 0; i < tested.size(); ++i) {
+      if (std::invoke(pred, tested[i])) {
+        selected.push(i);
+      }
+    }
+    soa_array result;
+    std::apply([&](auto&... out) {
+      std::apply([&](const auto&... in) {
+        (gather(out, in, selected), ...);
+      },
+        columns_);
+    },
+      result.columns_);
+    return result;
+  }
+
+  /**
+   * @brief Reserves memory in every column.
+   *
+   * @param new_capacity The new capacity of the array.
+   */
+  void reserve(size_type new_capacity) {
+    std::apply([&](auto&... col) { (col.reserve(new_capacity), ...); }, columns_);
+  }
+
+  /// @return The number of rows in the array.
+  [[nodiscard]] size_type size() const noexcept { return std::get<0>(columns_).size(); }
+  /// @return The number of rows the array can hold without reallocating.
+  [[nodiscard]] size_type capacity() const noexcept { return std::get<0>(columns_).capacity(); }
+  /// @brief Determines if the array is empty.
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  private:
+  void check_index(difference_type index) const {
+    if (index < 0 || static_cast<size_type>(index) >= size()) {
+      throw std::out_of_range("Index out of bounds");
+    }
+  }
+
+  template <typename Column>
+  static void gather(Column& out, const Column& in, const array<size_type>& selected) {
+    out.reserve(selected.size());
+    for (auto i : selected) {
+      out.push(in[i]);
+    }
+  }
+};
+
+} // namespace stdlib
+
+#endif // STD_LIB_SOA_ARRAY_H
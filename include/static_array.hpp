@@ -0,0 +1,427 @@
+#ifndef STD_LIB_STATIC_ARRAY_H
+#define STD_LIB_STATIC_ARRAY_H
+
+#include "array.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+namespace stdlib {
+
+/**
+ * @brief A fixed-capacity array class template that never allocates.
+ *
+ * The elements live inside the object, so a `static_array` can be built and
+ * returned by `consteval` functions and stored in a `constexpr` variable. It
+ * offers the same JS-style API as `array`, bounded by the capacity `N`.
+ *
+ * @code
+ * consteval auto squares() {
+ *   static_array<int, 8> table;
+ *   for (int i = 0; i < 8; ++i) table.push(i * i);
+ *   return table;
+ * }
+ * constexpr auto table = squares();
+ * @endcode
+ *
+ * @tparam T The type of elements stored in the array.
+ * @tparam N The capacity of the array.
+ */
+template <typename T, std::size_t N>
+class static_array {
+  private:
+  /// @brief The storage of the array.
+  std::array<T, N> array_ {};
+  /// @brief The length of the array.
+  std::size_t length_ = 0;
+
+  public:
+  /// @brief The type of elements stored in the array.
+  using value_type = T;
+  /// @brief The type of size of the array.
+  using size_type = std::size_t;
+  /// @brief The type of difference between iterators.
+  using difference_type = std::ptrdiff_t;
+  /// @brief The type of reference to elements.
+  using reference = T&;
+  /// @brief The type of const reference to elements.
+  using const_reference = const T&;
+  /// @brief The type of iterator.
+  using iterator = T*;
+  /// @brief The type of const iterator.
+  using const_iterator = const T*;
+
+  /// @brief Default constructor.
+  constexpr static_array() = default;
+
+  /**
+   * @brief Constructs an array from an initializer list.
+   *
+   * @param list The initializer list to construct the array from.
+   * @throws std::length_error If the list is longer than the capacity.
+   */
+  constexpr static_array(std::initializer_list<T> list) {
+    if (list.size() > N) {
+      throw std::length_error("Capacity exceeded");
+    }
+    std::ranges::copy(list, array_.begin());
+    length_ = list.size();
+  }
+
+  /**
+   * @brief Constructs an array from a range.
+   *
+   * @tparam Range The type of the range.
+   * @param range The range to construct the array from.
+   * @throws std::length_error If the range is longer than the capacity.
+   */
+  template <std::ranges::input_range Range>
+    requires(!std::same_as<std::remove_cvref_t<Range>, static_array>)
+  constexpr explicit static_array(Range&& range) {
+    for (auto&& value : range) {
+      push(value);
+    }
+  }
+
+  /**
+   * @brief Accesses an element by index.
+   *
+   * @param index The index of the element.
+   * @return Reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  constexpr reference operator[](difference_type index) {
+    if (index < 0 || static_cast<size_type>(index) >= size()) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    return array_[index];
+  }
+
+  /**
+   * @brief Accesses an element by index (const version).
+   *
+   * @param index The index of the element.
+   * @return Constant reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  constexpr const_reference operator[](difference_type index) const {
+    if (index < 0 || static_cast<size_type>(index) >= size()) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    return array_[index];
+  }
+
+  /**
+   * @brief Accesses an element by index with bounds checking.
+   *
+   * @param index The index of the element.
+   * @return Reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  constexpr reference at(difference_type index) { return (*this)[index]; }
+
+  /**
+   * @brief Accesses an element by index with bounds checking (const version).
+   *
+   * @param index The index of the element.
+   * @return Constant reference to the element.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  constexpr const_reference at(difference_type index) const { return (*this)[index]; }
+
+  /**
+   * @brief Compares this array with another array for equality.
+   *
+   * @param other The array to compare with.
+   * @return True if the arrays are equal, false otherwise.
+   */
+  constexpr bool operator==(const static_array& other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+  }
+
+  /**
+   * @brief Compares this array with another array.
+   *
+   * @param other The array to compare with.
+   * @return The result of the comparison.
+   */
+  constexpr auto operator<=>(const static_array& other) const {
+    return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
+  }
+
+  /**
+   * @brief Outputs the array to a stream.
+   *
+   * @param os The output stream.
+   * @param arr The array to output.
+   * @return The output stream.
+   */
+  friend std::ostream& operator<<(std::ostream& os, const static_array& arr) {
+    os << "[ ";
+    for (size_type i = 0; i < arr.size(); ++i) {
+      if (i > 0) os << ", ";
+      os << arr.array_[i];
+    }
+    os << " ]";
+    return os;
+  }
+
+  /**
+   * @brief Adds an element to the beginning of the array.
+   *
+   * @param value The value to add.
+   * @throws std::length_error If the array is full.
+   */
+  constexpr void unshift(const T& value) {
+    if (full()) {
+      throw std::length_error("Capacity exceeded");
+    }
+    std::move_backward(begin(), end(), end() + 1);
+    array_[0] = value;
+    ++length_;
+  }
+
+  /**
+   * @brief Removes and returns the first element of the array.
+   *
+   * @return The first element of the array.
+   * @throws std::out_of_range If the array is empty.
+   */
+  constexpr T shift() {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    T value = std::move(array_[0]);
+    std::move(begin() + 1, end(), begin());
+    --length_;
+    return value;
+  }
+
+  /**
+   * @brief Adds an element to the end of the array.
+   *
+   * @param value The value to add.
+   * @throws std::length_error If the array is full.
+   */
+  constexpr void push(const T& value) {
+    if (full()) {
+      throw std::length_error("Capacity exceeded");
+    }
+    array_[length_++] = value;
+  }
+
+  /**
+   * @brief Removes and returns the last element of the array.
+   *
+   * @return The last element of the array.
+   * @throws std::out_of_range If the array is empty.
+   */
+  constexpr T pop() {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    return std::move(array_[--length_]);
+  }
+
+  /**
+   * @brief Applies a function to each element of the array.
+   *
+   * @tparam F The type of the function.
+   * @param f The function to apply, called with the value (and its index).
+   */
+  template <typename F>
+  constexpr void for_each(F&& f) const {
+    for (size_type i = 0; i < size(); ++i) {
+      if constexpr (std::invocable<F&, const T&, size_type>) {
+        std::invoke(f, array_[i], i);
+      } else {
+        std::invoke(f, array_[i]);
+      }
+    }
+  }
+
+  /**
+   * @brief Filters the array using a predicate.
+   *
+   * @tparam Pred The type of the predicate.
+   * @param pred The predicate, called with the value (and its index).
+   * @return A new array with the elements that satisfy the predicate.
+   */
+  template <typename Pred>
+  constexpr static_array filter(Pred&& pred) const {
+    static_array result;
+    for (size_type i = 0; i < size(); ++i) {
+      bool keep;
+      if constexpr (std::invocable<Pred&, const T&, size_type>) {
+        keep = std::invoke(pred, array_[i], i);
+      } else {
+        keep = std::invoke(pred, array_[i]);
+      }
+      if (keep) result.array_[result.length_++] = array_[i];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Maps the array using a function.
+   *
+   * @tparam F The type of the function.
+   * @param f The function, called with the value (and its index).
+   * @return A new array with the mapped elements.
+   */
+  template <typename F>
+  constexpr auto map(F&& f) const {
+    if constexpr (std::invocable<F&, const T&, size_type>) {
+      static_array<std::remove_cvref_t<std::invoke_result_t<F&, const T&, size_type>>, N> result;
+      for (size_type i = 0; i < size(); ++i) {
+        result.push(std::invoke(f, array_[i], i));
+      }
+      return result;
+    } else {
+      static_array<std::remove_cvref_t<std::invoke_result_t<F&, const T&>>, N> result;
+      for (size_type i = 0; i < size(); ++i) {
+        result.push(std::invoke(f, array_[i]));
+      }
+      return result;
+    }
+  }
+
+  /**
+   * @brief Reduces the array to a single value using a function.
+   *
+   * @tparam U The type of the result (default is what `f` returns when called with `initial`).
+   * @tparam F The type of the function.
+   * @tparam I The type of the initial value.
+   * @param f The function, called with the accumulator and the value (and its index).
+   * @param initial The initial value.
+   * @return The reduced value.
+   */
+  template <typename U = void, typename F, typename I, typename R = detail::reduce_result_t<U, F, I, T>>
+  constexpr R reduce(F&& f, I&& initial) const {
+    return fold<R>(f, R(std::forward<I>(initial)), 0);
+  }
+
+  /**
+   * @brief Reduces the array to a single value using a function, starting from the first element.
+   *
+   * @tparam F The type of the function.
+   * @param f The function, called with the accumulator and the value (and its index).
+   * @return The reduced value.
+   * @throws std::out_of_range If the array is empty.
+   */
+  template <typename F>
+  constexpr T reduce(F&& f) const {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    return fold<T>(f, array_[0], 1);
+  }
+
+  /**
+   * @brief Reverses the array.
+   *
+   * @return A new array with the elements in reverse order.
+   */
+  constexpr static_array reverse() const {
+    static_array result(*this);
+    std::ranges::reverse(result);
+    return result;
+  }
+
+  /**
+   * @brief Sorts the array.
+   *
+   * @tparam Compare The type of the comparison function.
+   * @param comp The comparison function (default is `std::ranges::less`).
+   * @return A new array with the elements in sorted order.
+   */
+  template <typename Compare = std::ranges::less>
+  constexpr static_array sort(Compare comp = {}) const {
+    static_array result(*this);
+    std::ranges::sort(result, comp);
+    return result;
+  }
+
+  /**
+   * @brief Slices the array.
+   *
+   * @param start The start index.
+   * @param end The end index (default is -1, which means the end of the array).
+   * @return A new array with the sliced elements.
+   */
+  constexpr static_array slice(difference_type start, difference_type end = -1) const {
+    if (end < 0) end += size();
+    start = std::clamp<difference_type>(start, 0, size());
+    end = std::clamp<difference_type>(end, start, size());
+    static_array result;
+    std::copy(begin() + start, begin() + end, result.array_.begin());
+    result.length_ = end - start;
+    return result;
+  }
+
+  /**
+   * @brief Joins the elements of the array into a string.
+   *
+   * Strings are quoted, as in `array<std::string>::join`.
+   *
+   * @param sep The separator to use (default is ",").
+   * @return A string with the joined elements.
+   */
+  std::string join(std::string_view sep = ",") const {
+    std::string result;
+    for (size_type i = 0; i < size(); ++i) {
+      if (i > 0) result += sep;
+      result += detail::format_element(array_[i]);
+    }
+    return result;
+  }
+
+  /// @return The the size of the array.
+  [[nodiscard]] constexpr size_type size() const noexcept { return length_; }
+  /// @return The capacity of the array.
+  [[nodiscard]] static constexpr size_type capacity() noexcept { return N; }
+  /// @brief Determines if the array is empty.
+  [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+  /// @brief Determines if the array is full.
+  [[nodiscard]] constexpr bool full() const noexcept { return size() == N; }
+  /// @return An iterator to the beginning of the array.
+  constexpr iterator begin() noexcept { return array_.data(); }
+  /// @return A const iterator to the beginning of the array.
+  constexpr const_iterator begin() const noexcept { return array_.data(); }
+  /// @return An iterator to the end of the array.
+  constexpr iterator end() noexcept { return array_.data() + length_; }
+  /// @return A const iterator to the end of the array.
+  constexpr const_iterator end() const noexcept { return array_.data() + length_; }
+
+  private:
+  template <typename U, typename F>
+  constexpr U fold(F& f, U accumulator, size_type first) const {
+    for (size_type i = first; i < size(); ++i) {
+      if constexpr (std::invocable<F&, U, const T&, size_type>) {
+        accumulator = std::invoke(f, std::move(accumulator), array_[i], i);
+      } else {
+        accumulator = std::invoke(f, std::move(accumulator), array_[i]);
+      }
+    }
+    return accumulator;
+  }
+
+  template <typename U, std::size_t M>
+  friend class static_array;
+};
+
+} // namespace stdlib
+
+#endif // STD_LIB_STATIC_ARRAY_H
@@ -0,0 +1,574 @@
+#ifndef STD_LIB_STRING_ARRAY_H
+#define STD_LIB_STRING_ARRAY_H
+
+#include "array.hpp"
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stdlib {
+
+/**
+ * @brief An array of strings packed into a single byte arena.
+ *
+ * The characters of every string are stored back to back in one buffer and
+ * the array keeps the end position of each string, so pushing a string copies
+ * its bytes instead of allocating, and elements are handed out as
+ * `std::string_view`s into the arena. Views stay valid until the array is
+ * modified.
+ *
+ * @code
+ * string_array words = { "to", "be" };
+ * words.push("or");
+ * words.join(); // "\"to\",\"be\",\"or\""
+ * @endcode
+ */
+class string_array {
+  public:
+  /// @brief The type of elements handed out by the array.
+  using value_type = std::string_view;
+  /// @brief The type of size of the array.
+  using size_type = std::size_t;
+  /// @brief The type of difference between iterators.
+  using difference_type = std::ptrdiff_t;
+
+  private:
+  /// @brief The characters of the strings.
+  std::unique_ptr<char[]> bytes_;
+  /// @brief The capacity of the arena in bytes.
+  size_type byte_capacity_ = 0;
+  /// @brief The position of the first character of the first string; the bytes before it are free.
+  size_type head_ = 0;
+  /// @brief The position one past the last character of each string.
+  array<size_type> ends_;
+
+  public:
+  /// @brief A random-access iterator over the strings, yielding views.
+  class const_iterator {
+    const string_array* owner_ = nullptr;
+    size_type index_ = 0;
+
+    public:
+    using iterator_category = std::input_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::string_view;
+
+    const_iterator() = default;
+    const_iterator(const string_array* owner, size_type index) :
+        owner_(owner), index_(index) { }
+
+    reference operator*() const { return owner_->view(index_); }
+    reference operator[](difference_type n) const { return owner_->view(index_ + n); }
+
+    const_iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto copy = *this;
+      ++index_;
+      return copy;
+    }
+    const_iterator& operator--() {
+      --index_;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      auto copy = *this;
+      --index_;
+      return copy;
+    }
+    const_iterator& operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    const_iterator& operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+    friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+    friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+    friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const const_iterator& lhs, const const_iterator& rhs) {
+      return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ == rhs.index_; }
+    friend auto operator<=>(const const_iterator& lhs, const const_iterator& rhs) { return lhs.index_ <=> rhs.index_; }
+  };
+
+  /// @brief The type of iterator.
+  using iterator = const_iterator;
+
+  /// @brief Default constructor.
+  string_array() = default;
+
+  /**
+   * @brief Constructs an array from an initializer list.
+   *
+   * @param list The initializer list to construct the array from.
+   */
+  string_array(std::initializer_list<std::string_view> list) {
+    size_type bytes = 0;
+    for (std::string_view value : list) bytes += value.size();
+    reserve(list.size(), bytes);
+    for (std::string_view value : list) push(value);
+  }
+
+  /**
+   * @brief Constructs an array from an array of strings.
+   *
+   * @param strings The strings to copy.
+   */
+  explicit string_array(const array<std::string>& strings) {
+    size_type bytes = 0;
+    for (const std::string& value : strings) bytes += value.size();
+    reserve(strings.size(), bytes);
+    for (const std::string& value : strings) push(value);
+  }
+
+  /**
+   * @brief Copy constructor.
+   *
+   * Only the bytes of the strings are copied; free space is dropped.
+   *
+   * @param other The array to copy from.
+   */
+  string_array(const string_array& other) :
+      string_array(other.copy_range(0, other.size())) { }
+
+  /**
+   * @brief Move constructor.
+   *
+   * @param other The array to move from.
+   */
+  string_array(string_array&& other) noexcept :
+      bytes_(std::move(other.bytes_)), byte_capacity_(std::exchange(other.byte_capacity_, 0)),
+      head_(std::exchange(other.head_, 0)), ends_(std::move(other.ends_)) { }
+
+  /**
+   * @brief Copy assignment operator.
+   *
+   * @param other The array to copy from.
+   * @return Reference to this array.
+   */
+  string_array& operator=(const string_array& other) {
+    if (this != &other) {
+      string_array temp(other);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * @param other The array to move from.
+   * @return Reference to this array.
+   */
+  string_array& operator=(string_array&& other) noexcept {
+    string_array temp(std::move(other));
+    swap(temp);
+    return *this;
+  }
+
+  /**
+   * @brief Swaps the contents of this array with another array.
+   *
+   * @param other The array to swap with.
+   */
+  void swap(string_array& other) noexcept {
+    using std::swap;
+    swap(bytes_, other.bytes_);
+    swap(byte_capacity_, other.byte_capacity_);
+    swap(head_, other.head_);
+    swap(ends_, other.ends_);
+  }
+
+  /**
+   * @brief Swaps the contents of two arrays.
+   *
+   * @param lhs The first array.
+   * @param rhs The second array.
+   */
+  friend void swap(string_array& lhs, string_array& rhs) noexcept { lhs.swap(rhs); }
+
+  /**
+   * @brief Accesses a string by index.
+   *
+   * @param index The index of the string.
+   * @return A view of the string.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  std::string_view operator[](difference_type index) const {
+    if (index < 0 || static_cast<size_type>(index) >= size()) {
+      throw std::out_of_range("Index out of bounds");
+    }
+    return view(index);
+  }
+
+  /**
+   * @brief Accesses a string by index with bounds checking.
+   *
+   * @param index The index of the string.
+   * @return A view of the string.
+   * @throws std::out_of_range If the index is out of bounds.
+   */
+  std::string_view at(difference_type index) const { return (*this)[index]; }
+
+  /**
+   * @brief Compares this array with another array for equality.
+   *
+   * @param other The array to compare with.
+   * @return True if the arrays are equal, false otherwise.
+   */
+  bool operator==(const string_array& other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+  }
+
+  /**
+   * @brief Outputs the array to a stream.
+   *
+   * @param os The output stream.
+   * @param arr The array to output.
+   * @return The output stream.
+   */
+  friend std::ostream& operator<<(std::ostream& os, const string_array& arr) {
+    os << "[ ";
+    for (size_type i = 0; i < arr.size(); ++i) {
+      if (i > 0) os << ", ";
+      os << arr.view(i);
+    }
+    os << " ]";
+    return os;
+  }
+
+  /**
+   * @brief Adds a string to the beginning of the array.
+   *
+   * Uses the free bytes left in front by `shift()` when they suffice;
+   * otherwise the bytes of every string are moved.
+   *
+   * @param value The string to add; it may be a view of a string of this array.
+   */
+  void unshift(std::string_view value) {
+    if (aliases(value)) {
+      unshift(std::string(value));
+      return;
+    }
+    if (head_ < value.size()) {
+      size_type used = bytes_end() - head_;
+      size_type capacity = std::max(byte_capacity_, used + value.size());
+      auto bytes = std::make_unique_for_overwrite<char[]>(capacity);
+      copy_bytes(bytes.get() + value.size(), bytes_.get() + head_, used);
+      rebase(value.size() - head_);
+      bytes_ = std::move(bytes);
+      byte_capacity_ = capacity;
+      head_ = value.size();
+    }
+    ends_.unshift(head_);
+    head_ -= value.size();
+    copy_bytes(bytes_.get() + head_, value.data(), value.size());
+  }
+
+  /**
+   * @brief Removes and returns the first string of the array.
+   *
+   * @return The first string of the array.
+   * @throws std::out_of_range If the array is empty.
+   */
+  std::string shift() {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    std::string value(view(0));
+    head_ = ends_.shift();
+    if (empty()) head_ = 0;
+    return value;
+  }
+
+  /**
+   * @brief Adds a string to the end of the array.
+   *
+   * @param value The string to add; it may be a view of a string of this array.
+   */
+  void push(std::string_view value) {
+    if (aliases(value)) {
+      push(std::string(value));
+      return;
+    }
+    make_room(value.size());
+    size_type end = bytes_end();
+    copy_bytes(bytes_.get() + end, value.data(), value.size());
+    ends_.push(end + value.size());
+  }
+
+  /**
+   * @brief Removes and returns the last string of the array.
+   *
+   * @return The last string of the array.
+   * @throws std::out_of_range If the array is empty.
+   */
+  std::string pop() {
+    if (empty()) {
+      throw std::out_of_range("Array is empty");
+    }
+    std::string value(view(size() - 1));
+    ends_.pop();
+    if (empty()) head_ = 0;
+    return value;
+  }
+
+  /**
+   * @brief Applies a function to each string of the array.
+   *
+   * @tparam F The type of the function.
+   * @param f The function to apply, called with a view of the string (and its index).
+   */
+  template <typename F>
+  void for_each(F&& f) const {
+    for (size_type i = 0; i < size(); ++i) {
+      if constexpr (std::invocable<F&, std::string_view, size_type>) {
+        std::invoke(f, view(i), i);
+      } else {
+        std::invoke(f, view(i));
+      }
+    }
+  }
+
+  /**
+   * @brief Maps the array using a function.
+   *
+   * @tparam F The type of the function.
+   * @param f The function, called with a view of each string.
+   * @return A new array with the mapped elements.
+   */
+  template <std::invocable<std::string_view> F>
+  auto map(F&& f) const -> array<std::remove_cvref_t<std::invoke_result_t<F&, std::string_view>>> {
+    array<std::remove_cvref_t<std::invoke_result_t<F&, std::string_view>>> result(size());
+    for (size_type i = 0; i < size(); ++i) {
+      result[i] = std::invoke(f, view(i));
+    }
+    return result;
+  }
+
+  /**
+   * @brief Filters the array using a predicate.
+   *
+   * The predicate is evaluated once per string while the selected bytes are
+   * counted, so the result is allocated exactly once.
+   *
+   * @tparam Pred The type of the predicate.
+   * @param pred The predicate, called with a view of each string.
+   * @return A new array with the strings that satisfy the predicate.
+   */
+  template <std::invocable<std::string_view> Pred>
+  string_array filter(Pred&& pred) const {
+    std::vector<unsigned char> keep(size());
+    size_type count = 0;
+    size_type bytes = 0;
+    for (size_type i = 0; i < size(); ++i) {
+      keep[i] = static_cast<bool>(std::invoke(pred, view(i)));
+      count += keep[i];
+      bytes += keep[i] ? view(i).size() : 0;
+    }
+    string_array result;
+    result.reserve(count, bytes);
+    for (size_type i = 0; i < size(); ++i) {
+      if (keep[i]) result.push(view(i));
+    }
+    return result;
+  }
+
+  /**
+   * @brief Reduces the array to a single value using a function.
+   *
+   * @tparam U The type of the result (default is what `f` returns when called with `initial`).
+   * @tparam F The type of the function.
+   * @tparam I The type of the initial value.
+   * @param f The function, called with the accumulator and a view of each string.
+   * @param initial The initial value.
+   * @return The reduced value.
+   */
+  template <typename U = void, typename F, typename I, typename R = detail::reduce_result_t<U, F, I, std::string_view>>
+    requires std::invocable<F&, R, std::string_view>
+  R reduce(F&& f, I&& initial) const {
+    R accumulator(std::forward<I>(initial));
+    for (size_type i = 0; i < size(); ++i) {
+      accumulator = std::invoke(f, std::move(accumulator), view(i));
+    }
+    return accumulator;
+  }
+
+  /**
+   * @brief Slices the array.
+   *
+   * Copies the positions of the selected strings and their bytes in one block.
+   *
+   * @param start The start index.
+   * @param end The end index (default is -1, which means the end of the array).
+   * @return A new array with the sliced strings.
+   */
+  string_array slice(difference_type start, difference_type end = -1) const {
+    if (end < 0) end += size();
+    start = std::clamp<difference_type>(start, 0, size());
+    end = std::clamp<difference_type>(end, start, size());
+    return copy_range(start, end);
+  }
+
+  /**
+   * @brief Joins the strings of the array into a string.
+   *
+   * Each string is quoted, as in `array<std::string>::join`. The length of
+   * the result is computed first and the bytes are then copied in one sweep.
+   *
+   * @param sep The separator to use (default is ",").
+   * @return A string with the joined strings.
+   */
+  std::string join(std::string_view sep = ",") const {
+    if (empty()) return {};
+    std::string result(byte_size() + 2 * size() + sep.size() * (size() - 1), '\0');
+    char* out = result.data();
+    const char* bytes = bytes_.get();
+    const size_type* ends = ends_.begin();
+    size_type first = head_;
+    for (size_type i = 0; i < size(); ++i) {
+      if (i > 0) {
+        std::memcpy(out, sep.data(), sep.size());
+        out += sep.size();
+      }
+      *out++ = '"';
+      copy_bytes(out, bytes + first, ends[i] - first);
+      out += ends[i] - first;
+      *out++ = '"';
+      first = ends[i];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Copies the strings into an array of `std::string`.
+   *
+   * @return A new array with the strings.
+   */
+  array<std::string> to_array() const {
+    array<std::string> result(size());
+    for (size_type i = 0; i < size(); ++i) {
+      result[i] = std::string(view(i));
+    }
+    return result;
+  }
+
+  /**
+   * @brief Reserves memory for the array.
+   *
+   * @param strings The new capacity in strings.
+   * @param bytes The new capacity in characters.
+   */
+  void reserve(size_type strings, size_type bytes) {
+    ends_.reserve(strings);
+    if (bytes > byte_capacity_) {
+      reallocate(bytes);
+    }
+  }
+
+  /// @return The the size of the array.
+  [[nodiscard]] size_type size() const noexcept { return ends_.size(); }
+  /// @return The total number of characters of the strings.
+  [[nodiscard]] size_type byte_size() const noexcept { return bytes_end() - head_; }
+  /// @return The capacity of the arena in bytes.
+  [[nodiscard]] size_type byte_capacity() const noexcept { return byte_capacity_; }
+  /// @brief Determines if the array is empty.
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+  /// @return An iterator to the beginning of the array.
+  const_iterator begin() const noexcept { return { this, 0 }; }
+  /// @return An iterator to the end of the array.
+  const_iterator end() const noexcept { return { this, size() }; }
+
+  private:
+  /// @brief `std::memcpy` that accepts a null pointer when there is nothing to copy.
+  static void copy_bytes(char* out, const char* in, size_type n) noexcept {
+    if (n > 0) std::memcpy(out, in, n);
+  }
+
+  /// @brief Whether `value` points into the arena, whose bytes `push` and `unshift` may move or free.
+  bool aliases(std::string_view value) const noexcept {
+    std::less<const char*> less;
+    const char* data = bytes_.get();
+    return !value.empty() && data && !less(value.data(), data) && less(value.data(), data + byte_capacity_);
+  }
+
+  size_type bytes_end() const noexcept { return empty() ? head_ : ends_.end()[-1]; }
+
+  std::string_view view(size_type index) const noexcept {
+    const size_type* ends = ends_.begin();
+    size_type first = index == 0 ? head_ : ends[index - 1];
+    return { bytes_.get() + first, ends[index] - first };
+  }
+
+  /// @brief Adds `delta` (modulo the size type) to every end position.
+  void rebase(size_type delta) noexcept {
+    for (size_type& end : ends_) end += delta;
+  }
+
+  /// @brief Moves the strings to the front of a new arena of `capacity` bytes.
+  void reallocate(size_type capacity) {
+    size_type used = byte_size();
+    auto bytes = std::make_unique_for_overwrite<char[]>(capacity);
+    copy_bytes(bytes.get(), bytes_.get() + head_, used);
+    rebase(-head_);
+    bytes_ = std::move(bytes);
+    byte_capacity_ = capacity;
+    head_ = 0;
+  }
+
+  /**
+   * @brief Ensures that `n` more bytes fit after the last string.
+   *
+   * Reclaims the bytes freed by `shift()` in place when that leaves the arena
+   * at most half full, and otherwise grows it geometrically.
+   */
+  void make_room(size_type n) {
+    if (bytes_end() + n <= byte_capacity_) return;
+    size_type used = byte_size();
+    if (used + n <= byte_capacity_ / 2) {
+      std::memmove(bytes_.get(), bytes_.get() + head_, used);
+      rebase(-head_);
+      head_ = 0;
+    } else {
+      reallocate(std::max(byte_capacity_ * 2, used + n));
+    }
+  }
+
+  /// @brief Copies the strings `[start, end)` with their bytes into a new compact array.
+  string_array copy_range(size_type start, size_type end) const {
+    string_array result;
+    if (start == end) return result;
+    size_type first = start == 0 ? head_ : ends_.begin()[start - 1];
+    size_type last = ends_.begin()[end - 1];
+    result.bytes_ = std::make_unique_for_overwrite<char[]>(last - first);
+    result.byte_capacity_ = last - first;
+    copy_bytes(result.bytes_.get(), bytes_.get() + first, last - first);
+    result.ends_ = array<size_type>(end - start);
+    std::transform(ends_.begin() + start, ends_.begin() + end, result.ends_.begin(), [first](size_type e) { return e - first; });
+    return result;
+  }
+};
+
+} // namespace stdlib
+
+#endif // STD_LIB_STRING_ARRAY_H
@@ -1,8 +1,12 @@
 #include "array.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include <cstdint>
 
 using namespace stdlib;
 
+template <typename A>
+concept can_roll = requires(A&& arr) { std::forward<A>(arr).rolling(1); };
+
 TEST_CASE("Array construction", "[array]") {
   SECTION("Default constructor") {
     array<int> arr;
@@ -198,4 +202,306 @@ TEST_CASE("Array utility functions", "[array]") {
   SECTION("join()") {
     REQUIRE(arr.join(", ") == "1, 2, 3, 4, 5");
   }
-}
\ No newline at end of file
+}
+TEST_CASE("Array parsing", "[array]") {
+  SECTION("parse()") {
+    auto arr = array<int>::parse("1,2,-3,+4");
+    REQUIRE(arr == array<int> { 1, 2, -3, 4 });
+    REQUIRE(array<int>::parse("").empty());
+    REQUIRE(array<int>::parse("7 | 8", "|") == array<int> { 7, 8 });
+    REQUIRE_THROWS_AS(array<int>::parse("1,x"), std::invalid_argument);
+    REQUIRE_THROWS_AS(array<int>::parse("+-3"), std::invalid_argument);
+    REQUIRE_THROWS_AS(array<int>::parse("+"), std::invalid_argument);
+    REQUIRE(array<double>::parse("+.5,+2") == array<double> { 0.5, 2 });
+    REQUIRE_THROWS_AS(array<int>::parse("1,2", ""), std::invalid_argument);
+  }
+
+  SECTION("round trip join() and operator<<") {
+    array<double> arr = { 1.5, -2.25, 3 };
+    REQUIRE(array<double>::parse(arr.join()) == arr);
+    REQUIRE(array<double>::parse(arr.join(", "), ", ") == arr);
+    std::ostringstream os;
+    os << arr;
+    REQUIRE(array<double>::parse(os.str()) == arr);
+    REQUIRE(array<int>::parse("[  ]").empty());
+  }
+
+  SECTION("from_stream()") {
+    std::istringstream is("10\n20\n30\n");
+    REQUIRE(array<long>::from_stream(is, "\n") == array<long> { 10, 20, 30 });
+  }
+
+  SECTION("parallel parse()") {
+    array<int> arr;
+    for (int i = 0; i < 200000; ++i) {
+      arr.push(i - 1000);
+    }
+    std::string text = arr.join(";;");
+    REQUIRE(array<int>::parse(parallel_t { 4 }, text, ";;") == arr);
+    std::istringstream is(text);
+    REQUIRE(array<int>::from_stream(parallel_t { 3 }, is, ";;") == arr);
+    REQUIRE_THROWS_AS(array<int>::parse(parallel_t { 4 }, text + ";;oops", ";;"), std::invalid_argument);
+  }
+}
+
+namespace {
+constexpr int constexpr_pipeline() {
+  array<int> arr;
+  for (int i = 1; i <= 6; ++i) {
+    arr.push(i);
+  }
+  arr.unshift(0);
+  arr.shift();
+  auto evens = arr.filter([](int x) { return x % 2 == 0; });
+  auto squares = evens.map([](int x) { return x * x; });
+  auto sorted = (squares + arr.slice(0, 2)).reverse().sort();
+  return sorted.reduce([](int acc, int x) { return acc * 10 + x % 10; }, 0);
+}
+} // namespace
+
+TEST_CASE("Array constant evaluation", "[array]") {
+  // evens { 2, 4, 6 } -> squares { 4, 16, 36 } + { 1, 2 } -> sorted { 1, 2, 4, 16, 36 }
+  static_assert(constexpr_pipeline() == 12466);
+  REQUIRE(constexpr_pipeline() == 12466);
+}
+
+TEST_CASE("Array functional API", "[array]") {
+  array<int> arr = { 0, 1, 2, 3, 4 };
+
+  SECTION("for_each()") {
+    arr.for_each([](int& x) { x *= 2; });
+    REQUIRE(arr == array<int> { 0, 2, 4, 6, 8 });
+    std::size_t sum = 0;
+    arr.for_each([&sum](const int& x, std::size_t i) { sum += x * i; });
+    REQUIRE(sum == 60);
+  }
+
+  SECTION("reduce()") {
+    REQUIRE(arr.reduce([](int acc, int x) { return acc + x; }) == 10);
+    REQUIRE(arr.reduce([](int acc, int x, std::size_t i) { return acc + x * static_cast<int>(i); }, 0) == 30);
+    REQUIRE(arr.reduce<std::string>([](std::string acc, int x) { return acc + std::to_string(x); }, "") == "01234");
+    REQUIRE(arr.reduce([](double acc, int x) { return acc + x * 0.5; }, 0.0) == 5.0);
+    REQUIRE(arr.reduce([](auto acc, int x) { return acc + x * 0.25; }, 0.0) == 2.5);
+    REQUIRE(arr.reduce([](std::string acc, int x) { return acc + std::to_string(x); }, "") == "01234");
+    array<double> halves = { 0.5, 0.5 };
+    REQUIRE(halves.reduce([](double acc, double x) { return acc + x; }, 0) == 1.0);
+    REQUIRE_THROWS_AS(array<int>().reduce([](int acc, int x) { return acc + x; }), std::out_of_range);
+  }
+
+  SECTION("shift() keeps offset-aware members consistent") {
+    arr.shift();
+    arr.shift();
+    REQUIRE(arr.reduce([](int acc, int x) { return acc + x; }, 0) == 9);
+    arr.push(5);
+    arr.push(6);
+    arr.push(7);
+    REQUIRE(arr == array<int> { 2, 3, 4, 5, 6, 7 });
+    REQUIRE(arr.pop() == 7);
+    arr.insert(arr.begin() + 1, 10);
+    REQUIRE(arr == array<int> { 2, 10, 3, 4, 5, 6 });
+  }
+
+  SECTION("map() and filter() with strings") {
+    array<std::string> words = { "a", "bb", "ccc" };
+    auto lengths = words.map([](const std::string& w) { return w.size(); });
+    REQUIRE(lengths[2] == 3);
+    auto long_words = words.filter([](const std::string& w) { return w.size() > 1; });
+    REQUIRE(long_words.size() == 2);
+  }
+}
+
+namespace {
+template <typename T, typename Pred>
+array<T> filter_reference(const array<T>& arr, Pred pred) {
+  array<T> result;
+  for (const auto& value : arr) {
+    if (pred(value)) result.push(value);
+  }
+  return result;
+}
+
+template <typename T>
+void check_comparisons(const array<T>& arr, T operand) {
+  REQUIRE(arr.filter(less_than(operand)) == filter_reference(arr, [=](T x) { return x < operand; }));
+  REQUIRE(arr.filter(less_equal(operand)) == filter_reference(arr, [=](T x) { return x <= operand; }));
+  REQUIRE(arr.filter(greater_than(operand)) == filter_reference(arr, [=](T x) { return x > operand; }));
+  REQUIRE(arr.filter(greater_equal(operand)) == filter_reference(arr, [=](T x) { return x >= operand; }));
+  REQUIRE(arr.filter(equal_to(operand)) == filter_reference(arr, [=](T x) { return x == operand; }));
+  REQUIRE(arr.filter(not_equal_to(operand)) == filter_reference(arr, [=](T x) { return x != operand; }));
+}
+} // namespace
+
+TEST_CASE("Array filtering", "[array]") {
+  array<int> arr = { 5, 1, 4, 2, 3 };
+
+  SECTION("filter()") {
+    REQUIRE(arr.filter([](int x) { return x > 2; }) == array<int> { 5, 4, 3 });
+    REQUIRE(arr.filter([](int, std::size_t i) { return i % 2 == 0; }) == array<int> { 5, 4, 3 });
+    REQUIRE(arr.filter([](int) { return false; }).capacity() == 0);
+    array<std::string> words = { "x", "yy", "z" };
+    REQUIRE(words.filter([](const std::string& w) { return w.size() == 1; }) == array<std::string> { "x", "z" });
+  }
+
+  SECTION("filter() evaluates the predicate once per element") {
+    int calls = 0;
+    arr.filter([&calls](int x) { ++calls; return x > 2; });
+    REQUIRE(calls == 5);
+  }
+
+  SECTION("filter_into()") {
+    array<int> out;
+    arr.filter_into(out, greater_than(2));
+    REQUIRE(out == array<int> { 5, 4, 3 });
+    auto buffer = out.begin();
+    arr.filter_into(out, [](int x, std::size_t) { return x < 3; });
+    REQUIRE(out == array<int> { 1, 2 });
+    REQUIRE(out.begin() == buffer);
+    arr.filter_into(arr, less_than(5));
+    REQUIRE(arr == array<int> { 1, 4, 2, 3 });
+  }
+
+  SECTION("comparison predicates") {
+    array<std::int32_t> i32;
+    array<std::uint32_t> u32;
+    array<std::int64_t> i64;
+    array<std::uint64_t> u64;
+    array<float> f32;
+    array<double> f64;
+    for (int i = 0; i < 203; ++i) {
+      int value = (i * 37) % 101 - 50;
+      i32.push(value);
+      u32.push(static_cast<std::uint32_t>(value) * 3u);
+      i64.push(static_cast<std::int64_t>(value) << 33);
+      u64.push(static_cast<std::uint64_t>(value) * 3u);
+      f32.push(value / 4.0f);
+      f64.push(value / 8.0);
+    }
+    check_comparisons<std::int32_t>(i32, 7);
+    check_comparisons<std::uint32_t>(u32, 3000000000u);
+    check_comparisons<std::int64_t>(i64, std::int64_t { 7 } << 33);
+    check_comparisons<std::uint64_t>(u64, 30);
+    check_comparisons<float>(f32, 2.5f);
+    check_comparisons<double>(f64, -1.25);
+    REQUIRE(i32.filter(less_than(0.5)) == filter_reference(i32, [](int x) { return x < 0.5; }));
+    REQUIRE(i64.filter(greater_than(7)).size() == i64.filter(greater_than(std::int64_t { 7 })).size());
+  }
+}
+
+TEST_CASE("Array scans and windows", "[array]") {
+  array<int> arr = { 3, 1, 4, 1, 5, 9, 2, 6 };
+
+  SECTION("inclusive_scan() and exclusive_scan()") {
+    REQUIRE(arr.inclusive_scan() == array<int> { 3, 4, 8, 9, 14, 23, 25, 31 });
+    REQUIRE(arr.exclusive_scan(0) == array<int> { 0, 3, 4, 8, 9, 14, 23, 25 });
+    REQUIRE(arr.inclusive_scan([](int a, int b) { return std::max(a, b); }) == array<int> { 3, 3, 4, 4, 5, 9, 9, 9 });
+    REQUIRE(array<int>().inclusive_scan().empty());
+    REQUIRE(array<int>().exclusive_scan(0).empty());
+  }
+
+  SECTION("rolling()") {
+    REQUIRE(arr.rolling(3).sum() == array<int> { 8, 6, 10, 15, 16, 17 });
+    REQUIRE(arr.rolling(3).min() == array<int> { 1, 1, 1, 1, 2, 2 });
+    REQUIRE(arr.rolling(3).max() == array<int> { 4, 4, 5, 9, 9, 9 });
+    REQUIRE(arr.rolling(2).mean()[0] == 2.0);
+    array<std::uint8_t> bytes = { 200, 200, 200, 100 };
+    REQUIRE(bytes.rolling(2).mean() == array<double> { 200.0, 200.0, 150.0 });
+    array<int> large = { 2000000000, 2000000000, -2000000000 };
+    REQUIRE(large.rolling(2).mean() == array<double> { 2000000000.0, 0.0 });
+    REQUIRE(large.rolling(2).mean(parallel_t { 2 }) == large.rolling(2).mean());
+    REQUIRE(arr.rolling(1).max() == arr);
+    REQUIRE(arr.rolling(9).sum().empty());
+    REQUIRE_THROWS_AS(arr.rolling(0), std::invalid_argument);
+    static_assert(can_roll<const array<int>&>);
+    static_assert(!can_roll<array<int>>);
+  }
+
+  SECTION("partition()") {
+    array<std::string> words = { "a", "bb", "c", "dd", "e" };
+    auto [short_words, long_words] = words.partition([](const std::string& w) { return w.size() == 1; });
+    REQUIRE(short_words == array<std::string> { "a", "c", "e" });
+    REQUIRE(long_words == array<std::string> { "bb", "dd" });
+    auto [odd, even] = arr.partition([](int x) { return x % 2 == 1; });
+    REQUIRE(odd == array<int> { 3, 1, 1, 5, 9 });
+    REQUIRE(even == array<int> { 4, 2, 6 });
+  }
+
+  SECTION("parallel variants match the sequential ones") {
+    array<long> big;
+    for (long i = 0; i < 100003; ++i) {
+      big.push((i * 7919) % 1009 - 500);
+    }
+    parallel_t policy { 4 };
+    REQUIRE(big.inclusive_scan(policy) == big.inclusive_scan());
+    REQUIRE(big.exclusive_scan(policy, 10) == big.exclusive_scan(10));
+    REQUIRE(arr.inclusive_scan(policy) == arr.inclusive_scan());
+    REQUIRE(arr.exclusive_scan(policy, 1) == arr.exclusive_scan(1));
+    REQUIRE(big.rolling(17).sum(policy) == big.rolling(17).sum());
+    REQUIRE(big.rolling(17).min(policy) == big.rolling(17).min());
+    REQUIRE(big.rolling(17).max(policy) == big.rolling(17).max());
+    REQUIRE(big.rolling(17).mean(policy) == big.rolling(17).mean());
+    auto pred = [](long x) { return x > 0; };
+    REQUIRE(big.partition(policy, pred) == big.partition(pred));
+  }
+}
+
+TEST_CASE("Array hashing", "[array]") {
+  array<int> arr = { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3 };
+
+  SECTION("distinct()") {
+    REQUIRE(arr.distinct() == array<int> { 3, 1, 4, 5, 9, 2, 6 });
+    REQUIRE(array<int>().distinct().empty());
+    array<std::string> words = { "b", "a", "b", "c", "a" };
+    REQUIRE(words.distinct() == array<std::string> { "b", "a", "c" });
+  }
+
+  SECTION("count_by()") {
+    auto counts = arr.count_by([](int x) { return x % 3; });
+    REQUIRE(counts.size() == 3);
+    REQUIRE(counts.keys()[0] == 0);
+    REQUIRE(counts.at(0) == 4);
+    REQUIRE(counts.at(1) == 3);
+    REQUIRE(counts.at(2) == 3);
+  }
+
+  SECTION("group_by()") {
+    array<std::string> words = { "apple", "bob", "avocado", "cat", "banana" };
+    auto groups = words.group_by([](const std::string& w) { return w.front(); });
+    REQUIRE(groups.size() == 3);
+    REQUIRE(groups.at('a') == array<std::string> { "apple", "avocado" });
+    REQUIRE(groups.at('b') == array<std::string> { "bob", "banana" });
+    REQUIRE(groups.at('c') == array<std::string> { "cat" });
+    REQUIRE_THROWS_AS(groups.at('z'), std::out_of_range);
+  }
+
+  SECTION("index_by()") {
+    auto last = arr.index_by([](int x) { return x % 2; });
+    REQUIRE(last.size() == 2);
+    REQUIRE(last.at(1) == 3);
+    REQUIRE(last.at(0) == 6);
+  }
+
+  SECTION("parallel variants match the sequential ones") {
+    array<long> big;
+    for (long i = 0; i < 200003; ++i) {
+      big.push((i * 7919) % 10007);
+    }
+    parallel_t policy { 4 };
+    auto key = [](long x) { return x % 97; };
+    REQUIRE(big.distinct(policy) == big.distinct());
+
+    auto counts = big.count_by(policy, key);
+    auto expected_counts = big.count_by(key);
+    REQUIRE(std::ranges::equal(counts.keys(), expected_counts.keys()));
+    REQUIRE(std::ranges::equal(counts.values(), expected_counts.values()));
+
+    auto groups = big.group_by(policy, key);
+    auto expected_groups = big.group_by(key);
+    REQUIRE(std::ranges::equal(groups.keys(), expected_groups.keys()));
+    REQUIRE(std::ranges::equal(groups.values(), expected_groups.values()));
+
+    auto last = big.index_by(policy, key);
+    auto expected_last = big.index_by(key);
+    REQUIRE(std::ranges::equal(last.keys(), expected_last.keys()));
+    REQUIRE(std::ranges::equal(last.values(), expected_last.values()));
+  }
+}
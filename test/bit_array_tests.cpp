@@ -0,0 +1,114 @@
+#include "bit_array.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace stdlib;
+
+TEST_CASE("Bit array construction", "[bit_array]") {
+  SECTION("Constructor with size and value") {
+    bit_array flags(130, true);
+    REQUIRE(flags.size() == 130);
+    REQUIRE(flags.count() == 130);
+    REQUIRE(flags.all());
+    REQUIRE(flags.words().size() == 3);
+  }
+
+  SECTION("Initializer list and array<bool> constructors") {
+    bit_array flags = { true, false, true };
+    REQUIRE(flags == bit_array(array<bool> { true, false, true }));
+    REQUIRE(flags.join() == "true,false,true");
+  }
+}
+
+TEST_CASE("Bit array modification", "[bit_array]") {
+  bit_array flags;
+
+  SECTION("push() and pop()") {
+    for (int i = 0; i < 100; ++i) {
+      flags.push(i % 3 == 0);
+    }
+    REQUIRE(flags.size() == 100);
+    REQUIRE(flags.count() == 34);
+    REQUIRE(flags.pop() == true);
+    REQUIRE(flags.pop() == false);
+    REQUIRE(flags.count() == 33);
+    REQUIRE_THROWS_AS(bit_array().pop(), std::out_of_range);
+  }
+
+  SECTION("unshift() and shift() across words") {
+    for (int i = 0; i < 70; ++i) {
+      flags.push(i == 63 || i == 64);
+    }
+    flags.unshift(true);
+    REQUIRE(flags.size() == 71);
+    REQUIRE(flags[0]);
+    REQUIRE(flags[64]);
+    REQUIRE(flags[65]);
+    REQUIRE(flags.shift());
+    REQUIRE(flags.shift() == false);
+    REQUIRE(flags[62]);
+    REQUIRE(flags[63]);
+    REQUIRE(flags.count() == 2);
+  }
+
+  SECTION("operator[] proxies") {
+    flags = bit_array(10);
+    flags[3] = true;
+    flags[4] = flags[3];
+    REQUIRE(flags.count() == 2);
+    flags.at(3) = false;
+    REQUIRE(!flags[3]);
+    REQUIRE_THROWS_AS(flags.at(10), std::out_of_range);
+  }
+}
+
+TEST_CASE("Bit array word operations", "[bit_array]") {
+  bit_array a(200);
+  bit_array b(200);
+  for (std::size_t i = 0; i < 200; i += 2) a[i] = true;
+  for (std::size_t i = 0; i < 200; i += 3) b[i] = true;
+
+  SECTION("and, or, xor and not") {
+    REQUIRE((a & b).count() == 34);
+    REQUIRE((a | b).count() == 100 + 67 - 34);
+    REQUIRE((a ^ b).count() == 100 + 67 - 2 * 34);
+    REQUIRE((~a).count() == 100);
+    REQUIRE((~bit_array(3)).all());
+    REQUIRE_THROWS_AS(a & bit_array(3), std::invalid_argument);
+  }
+
+  SECTION("find_first() and find_next()") {
+    bit_array sparse(300);
+    REQUIRE(sparse.find_first() == bit_array::npos);
+    sparse[5] = true;
+    sparse[190] = true;
+    REQUIRE(sparse.find_first() == 5);
+    REQUIRE(sparse.find_next(5) == 190);
+    REQUIRE(sparse.find_next(190) == bit_array::npos);
+    REQUIRE(sparse.find_next(bit_array::npos) == bit_array::npos);
+    REQUIRE(sparse.find_next(299) == bit_array::npos);
+    std::size_t visits = 0;
+    for (auto i = sparse.find_first(); i != bit_array::npos; i = sparse.find_next(i)) {
+      ++visits;
+    }
+    REQUIRE(visits == 2);
+  }
+
+  SECTION("slice()") {
+    auto part = b.slice(3, 133);
+    REQUIRE(part.size() == 130);
+    REQUIRE(part[0]);
+    REQUIRE(part[3]);
+    REQUIRE(!part[4]);
+    REQUIRE(part.count() == 44);
+  }
+
+  SECTION("filter_by_mask()") {
+    array<int> values;
+    for (int i = 0; i < 200; ++i) values.push(i);
+    auto selected = filter_by_mask(values, a & b);
+    REQUIRE(selected.size() == 34);
+    REQUIRE(selected[1] == 6);
+    REQUIRE(selected[33] == 198);
+    REQUIRE_THROWS_AS(filter_by_mask(values, bit_array(3)), std::invalid_argument);
+  }
+}
@@ -0,0 +1,122 @@
+#include "hash_map.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <string>
+
+using namespace stdlib;
+
+namespace {
+
+/// @brief A value whose default constructor throws once its budget runs out.
+struct fragile {
+  static inline int budget = -1;
+  int value = 0;
+
+  fragile() {
+    if (budget == 0) throw std::runtime_error("out of budget");
+    if (budget > 0) --budget;
+  }
+};
+
+} // namespace
+
+TEST_CASE("Hash map", "[hash_map]") {
+  hash_map<std::string, int> map;
+
+  SECTION("operator[] inserts default values") {
+    REQUIRE(map.empty());
+    map["a"] += 1;
+    map["b"] += 2;
+    map["a"] += 3;
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.at("a") == 4);
+    REQUIRE(map.at("b") == 2);
+  }
+
+  SECTION("at(), find() and contains()") {
+    map["x"] = 1;
+    REQUIRE(map.contains("x"));
+    REQUIRE_FALSE(map.contains("y"));
+    REQUIRE(*map.find("x") == 1);
+    REQUIRE(map.find("y") == nullptr);
+    REQUIRE_THROWS_AS(map.at("y"), std::out_of_range);
+  }
+
+  SECTION("insert() keeps existing values") {
+    REQUIRE(map.insert("k", 1));
+    REQUIRE_FALSE(map.insert("k", 2));
+    REQUIRE(map.at("k") == 1);
+  }
+
+  SECTION("entries keep insertion order across growth") {
+    hash_map<int, int> squares;
+    for (int i = 0; i < 10000; ++i) {
+      squares[i * 7] = i * i;
+    }
+    REQUIRE(squares.size() == 10000);
+    for (int i = 0; i < 10000; ++i) {
+      REQUIRE(squares.keys()[i] == i * 7);
+      REQUIRE(squares.at(i * 7) == i * i);
+    }
+    REQUIRE_FALSE(squares.contains(1));
+    int visited = 0;
+    squares.for_each([&](int key, int value) {
+      REQUIRE(value == (key / 7) * (key / 7));
+      ++visited;
+    });
+    REQUIRE(visited == 10000);
+  }
+
+  SECTION("reserve()") {
+    hash_map<int, int> reserved;
+    reserved.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+      reserved[i] = i;
+    }
+    REQUIRE(reserved.size() == 1000);
+    REQUIRE(reserved.at(999) == 999);
+  }
+
+  SECTION("a throwing insertion leaves the map unchanged") {
+    hash_map<int, fragile> map;
+    for (int i = 0; i < 13; ++i) {
+      map[i].value = i;
+    }
+    fragile::budget = 0;
+    REQUIRE_THROWS_AS(map[13], std::runtime_error);
+    fragile::budget = -1;
+    REQUIRE(map.size() == 13);
+    REQUIRE_FALSE(map.contains(13));
+    map[13].value = 13;
+    for (int i = 0; i < 14; ++i) {
+      REQUIRE(map.at(i).value == i);
+    }
+  }
+
+  SECTION("copies are independent") {
+    hash_map<std::string, int> original;
+    for (int i = 0; i < 100; ++i) {
+      original[std::to_string(i)] = i;
+    }
+    hash_map<std::string, int> copy = original;
+    copy["extra"] = -1;
+    copy["7"] = 70;
+    REQUIRE(copy.size() == 101);
+    REQUIRE(original.size() == 100);
+    REQUIRE_FALSE(original.contains("extra"));
+    REQUIRE(original.at("7") == 7);
+    REQUIRE(copy.at("7") == 70);
+    REQUIRE(copy.at("99") == 99);
+
+    hash_map<std::string, int> assigned;
+    assigned["other"] = 1;
+    assigned = copy;
+    REQUIRE(assigned.size() == 101);
+    REQUIRE(assigned.at("extra") == -1);
+    REQUIRE_FALSE(assigned.contains("other"));
+
+    hash_map<std::string, int> moved = std::move(assigned);
+    REQUIRE(moved.size() == 101);
+    REQUIRE(moved.at("42") == 42);
+  }
+}
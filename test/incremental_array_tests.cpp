@@ -0,0 +1,102 @@
+#include "incremental_array.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace stdlib;
+
+TEST_CASE("Incremental array", "[incremental_array]") {
+  incremental_array<int> arr = { 1, 2, 3, 4 };
+
+  SECTION("push() grows without moving every element at once") {
+    REQUIRE(arr.capacity() == 4);
+    REQUIRE_FALSE(arr.migrating());
+    arr.push(5);
+    REQUIRE(arr.capacity() == 8);
+    REQUIRE(arr.migrating());
+    REQUIRE(arr.join() == "1,2,3,4,5");
+    arr.push(6);
+    REQUIRE_FALSE(arr.migrating());
+    REQUIRE(arr.join() == "1,2,3,4,5,6");
+  }
+
+  SECTION("push() of an element during a migration") {
+    incremental_array<std::string> words;
+    array<std::string> expected;
+    for (int i = 0; i < 9; ++i) {
+      words.push(std::string(20, static_cast<char>('a' + i)));
+      expected.push(std::string(20, static_cast<char>('a' + i)));
+    }
+    REQUIRE(words.migrating());
+    for (int i = 2; words.migrating(); ++i) {
+      words.push(words[i]);
+      expected.push(expected[i]);
+    }
+    REQUIRE(words.to_array() == expected);
+    REQUIRE(words.join() == expected.join());
+  }
+
+  SECTION("references from operator[] stay valid together") {
+    arr.push(5);
+    REQUIRE(arr.migrating());
+    std::swap(arr[0], arr[3]);
+    arr[1] = arr[2];
+    REQUIRE(arr.join() == "4,3,3,1,5");
+  }
+
+  SECTION("elements stay reachable during a migration") {
+    incremental_array<int> big;
+    for (int i = 0; i < 100000; ++i) {
+      big.push(i);
+      if ((i & (i - 1)) == 0) {
+        REQUIRE(big[0] == 0);
+        REQUIRE(big[i] == i);
+      }
+    }
+    REQUIRE(big.size() == 100000);
+    REQUIRE(big.reduce<long long>([](long long sum, int x) { return sum + x; }, 0) == 4999950000LL);
+    REQUIRE(big.to_array()[99999] == 99999);
+  }
+
+  SECTION("pop() during a migration") {
+    arr.push(5);
+    REQUIRE(arr.migrating());
+    REQUIRE(arr.pop() == 5);
+    REQUIRE(arr.pop() == 4);
+    REQUIRE(arr.pop() == 3);
+    REQUIRE(arr.join() == "1,2");
+    REQUIRE(arr.pop() == 2);
+    REQUIRE(arr.pop() == 1);
+    REQUIRE_FALSE(arr.migrating());
+    REQUIRE_THROWS_AS(arr.pop(), std::out_of_range);
+  }
+
+  SECTION("operator[] and at()") {
+    arr[1] = 20;
+    REQUIRE(arr.at(1) == 20);
+    REQUIRE_THROWS_AS(arr[4], std::out_of_range);
+    REQUIRE_THROWS_AS(arr.at(-1), std::out_of_range);
+    std::ostringstream os;
+    os << arr;
+    REQUIRE(os.str() == "[ 1, 20, 3, 4 ]");
+  }
+
+  SECTION("reserve(), copies and moves") {
+    incremental_array<std::string> words;
+    for (int i = 0; i < 9; ++i) {
+      words.push(std::string(20, static_cast<char>('a' + i)));
+    }
+    REQUIRE(words.migrating());
+    incremental_array<std::string> copy = words;
+    REQUIRE(copy == words);
+    words.reserve(100);
+    REQUIRE(words.capacity() == 100);
+    REQUIRE(words.migrating());
+    words.finish_migration();
+    REQUIRE(words == copy);
+    incremental_array<std::string> moved = std::move(words);
+    REQUIRE(moved == copy);
+    REQUIRE(words.empty());
+  }
+}
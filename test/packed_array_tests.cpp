@@ -0,0 +1,123 @@
+#include "packed_array.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <sstream>
+
+using namespace stdlib;
+
+template <typename T>
+static void require_round_trip(const array<T>& values) {
+  packed_array<T> packed(values);
+  REQUIRE(packed.size() == values.size());
+  REQUIRE(packed.to_array() == values);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    REQUIRE(packed[i] == values[i]);
+  }
+  REQUIRE(std::ranges::equal(packed, values));
+}
+
+TEST_CASE("Packed array", "[packed_array]") {
+  SECTION("push(), operator[] and the unpacked tail") {
+    packed_array<int> arr = { 3, -1, 4 };
+    REQUIRE(arr.size() == 3);
+    REQUIRE(arr[1] == -1);
+    REQUIRE_THROWS_AS(arr[3], std::out_of_range);
+    REQUIRE_THROWS_AS(arr.at(-1), std::out_of_range);
+    for (int i = 0; i < 300; ++i) {
+      arr.push(i % 7);
+    }
+    REQUIRE(arr.size() == 303);
+    REQUIRE(arr[0] == 3);
+    REQUIRE(arr[130] == 127 % 7);
+    REQUIRE(arr[302] == 299 % 7);
+  }
+
+  SECTION("sorted ids compress with deltas") {
+    array<std::uint32_t> ids;
+    for (std::uint32_t i = 0; i < 100000; ++i) {
+      ids.push(1000000 + i * 3 + (i % 2));
+    }
+    require_round_trip(ids);
+    // Steps of 3 or 4 take one bit per value plus the block headers and checkpoints.
+    REQUIRE(packed_array<std::uint32_t>(ids).memory_usage() < ids.size());
+  }
+
+  SECTION("operator[] in delta blocks starts from the nearest checkpoint") {
+    array<std::int64_t> falling;
+    std::int64_t value = 1'000'000'000'000;
+    for (std::int64_t i = 0; i < 1000; ++i) {
+      value -= 100 + (i * 7919) % 13;
+      falling.push(value);
+    }
+    require_round_trip(falling);
+    packed_array<std::int64_t> packed(falling);
+    for (std::size_t i = 0; i < 896; i += packed_array<std::int64_t>::checkpoint_interval) {
+      REQUIRE(packed[i] == falling[i]);
+      REQUIRE(packed[i + 31] == falling[i + 31]);
+    }
+  }
+
+  SECTION("small counters compress with a frame of reference") {
+    array<std::int64_t> counters;
+    for (std::int64_t i = 0; i < 10000; ++i) {
+      counters.push(-50 + (i * 37) % 101);
+    }
+    require_round_trip(counters);
+    REQUIRE(packed_array<std::int64_t>(counters).memory_usage() < counters.size() * 2);
+  }
+
+  SECTION("extreme values") {
+    array<std::int64_t> wide;
+    array<std::uint64_t> unsigned_wide;
+    array<std::int8_t> narrow;
+    for (int i = 0; i < 1000; ++i) {
+      wide.push(i % 2 ? std::numeric_limits<std::int64_t>::max() - i : std::numeric_limits<std::int64_t>::min() + i);
+      unsigned_wide.push(static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ULL);
+      narrow.push(static_cast<std::int8_t>(i * 13));
+    }
+    require_round_trip(wide);
+    require_round_trip(unsigned_wide);
+    require_round_trip(narrow);
+    require_round_trip(array<int>(500, 42));
+  }
+
+  SECTION("reduce(), sum() and for_each()") {
+    array<int> values;
+    for (int i = 1; i <= 1000; ++i) {
+      values.push(i);
+    }
+    packed_array<int> packed(values);
+    REQUIRE(packed.sum() == 500500);
+    REQUIRE(packed.sum<long long>() == 500500);
+    REQUIRE(packed.reduce([](int a, int b) { return std::max(a, b); }, 0) == 1000);
+    std::size_t visited = 0;
+    packed.for_each([&](int value, std::size_t i) {
+      REQUIRE(value == static_cast<int>(i) + 1);
+      ++visited;
+    });
+    REQUIRE(visited == 1000);
+    REQUIRE(packed == packed_array<int>(values));
+  }
+
+  SECTION("iterators") {
+    static_assert(std::ranges::input_range<packed_array<int>>);
+    packed_array<int> packed;
+    for (int i = 0; i < 300; ++i) {
+      packed.push(i * 3);
+    }
+    int expected = 0;
+    for (auto it = packed.begin(); it != packed.end(); it++) {
+      REQUIRE(*it == expected);
+      expected += 3;
+    }
+    REQUIRE(expected == 900);
+  }
+
+  SECTION("operator<<") {
+    std::ostringstream os;
+    os << packed_array<std::uint8_t> { 1, 2, 255 };
+    REQUIRE(os.str() == "[ 1, 2, 255 ]");
+  }
+}
@@ -0,0 +1,80 @@
+#include "segmented_array.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+using namespace stdlib;
+
+TEST_CASE("Segmented array modification", "[segmented_array]") {
+  segmented_array<int, 4> arr;
+
+  SECTION("push() and pop() keep references stable") {
+    arr.push(0);
+    int* first = &arr[0];
+    for (int i = 1; i < 10; ++i) {
+      arr.push(i);
+    }
+    REQUIRE(&arr[0] == first);
+    REQUIRE(arr.size() == 10);
+    REQUIRE(arr.capacity() == 12);
+    REQUIRE(arr.pop() == 9);
+    REQUIRE(arr.pop() == 8);
+    REQUIRE(arr.capacity() == 8);
+    REQUIRE(arr[7] == 7);
+    REQUIRE_THROWS_AS(arr.at(8), std::out_of_range);
+  }
+
+  SECTION("unshift() and shift()") {
+    for (int i = 0; i < 6; ++i) {
+      arr.unshift(i);
+    }
+    REQUIRE(arr.join() == "5,4,3,2,1,0");
+    for (int i = 5; i >= 0; --i) {
+      REQUIRE(arr.shift() == i);
+    }
+    REQUIRE(arr.empty());
+    REQUIRE_THROWS_AS(arr.shift(), std::out_of_range);
+    REQUIRE_THROWS_AS(arr.pop(), std::out_of_range);
+  }
+}
+
+TEST_CASE("Segmented array access", "[segmented_array]") {
+  segmented_array<int, 4> arr;
+  for (int i = 0; i < 11; ++i) {
+    arr.push(i);
+  }
+  arr.shift();
+
+  SECTION("random-access iterators") {
+    static_assert(std::random_access_iterator<segmented_array<int, 4>::iterator>);
+    REQUIRE(arr.end() - arr.begin() == 10);
+    REQUIRE(*(arr.begin() + 5) == 6);
+    REQUIRE(std::ranges::is_sorted(arr));
+    int total = 0;
+    for (int value : arr) total += value;
+    REQUIRE(total == 55);
+  }
+
+  SECTION("chunks() and to_contiguous()") {
+    auto chunks = arr.chunks();
+    REQUIRE(chunks.size() == 3);
+    REQUIRE(chunks[0].size() == 3);
+    REQUIRE(chunks[2].size() == 3);
+    REQUIRE(chunks[0][0] == 1);
+    REQUIRE(arr.to_contiguous() == array<int> { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 });
+  }
+
+  SECTION("functional API") {
+    REQUIRE(arr.map([](int x) { return x * 2; })[9] == 20);
+    REQUIRE(arr.filter([](int x) { return x % 2 == 0; }).join() == "2,4,6,8,10");
+    REQUIRE(arr.reduce([](int acc, int x) { return acc + x; }, 0) == 55);
+    REQUIRE(arr.slice(2, 5).join() == "3,4,5");
+    segmented_array<std::string, 2> words;
+    for (const char* word : { "a", "b", "c" }) {
+      words.push(word);
+    }
+    REQUIRE(words.join() == array<std::string> { "a", "b", "c" }.join());
+    REQUIRE(words.join(" ") == "\"a\" \"b\" \"c\"");
+    segmented_array<int, 4> copy = arr;
+    REQUIRE(copy == arr);
+  }
+}
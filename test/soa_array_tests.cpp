@@ -0,0 +1,88 @@
+#include "soa_array.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace stdlib;
+
+namespace {
+struct event {
+  long ts = 0;
+  double value = 0;
+  int kind = 0;
+};
+
+using events = soa_array<event, &event::ts, &event::value, &event::kind>;
+} // namespace
+
+TEST_CASE("SoA array modification", "[soa_array]") {
+  events arr;
+
+  SECTION("push() and pop()") {
+    arr.push({ 1, 1.5, 7 });
+    arr.push({ 2, 2.5, 8 });
+    REQUIRE(arr.size() == 2);
+    event last = arr.pop();
+    REQUIRE(last.ts == 2);
+    REQUIRE(last.value == 2.5);
+    REQUIRE(last.kind == 8);
+    REQUIRE(arr.size() == 1);
+    arr.pop();
+    REQUIRE_THROWS_AS(arr.pop(), std::out_of_range);
+  }
+
+  SECTION("unshift() and shift()") {
+    arr.unshift({ 1, 1.5, 7 });
+    arr.unshift({ 2, 2.5, 8 });
+    REQUIRE(arr[0].get<&event::ts>() == 2);
+    event first = arr.shift();
+    REQUIRE(first.kind == 8);
+    REQUIRE(arr.size() == 1);
+    REQUIRE(arr[0].get<&event::kind>() == 7);
+    arr.shift();
+    REQUIRE_THROWS_AS(arr.shift(), std::out_of_range);
+  }
+
+  SECTION("row proxies") {
+    arr = { { 1, 1.5, 7 }, { 2, 2.5, 8 } };
+    arr[1] = event { 3, 3.5, 9 };
+    event row = arr[1];
+    REQUIRE(row.ts == 3);
+    REQUIRE(row.value == 3.5);
+    arr[0].get<&event::value>() = 4.0;
+    REQUIRE(arr.at(0).get<&event::value>() == 4.0);
+    REQUIRE_THROWS_AS(arr.at(2), std::out_of_range);
+  }
+}
+
+TEST_CASE("SoA array column operations", "[soa_array]") {
+  events arr = { { 1, 1.0, 0 }, { 2, 2.0, 1 }, { 3, 3.0, 0 }, { 4, 4.0, 1 } };
+
+  SECTION("column() and span()") {
+    REQUIRE(arr.column<&event::ts>().size() == 4);
+    REQUIRE(arr.column<&event::ts>()[3] == 4);
+    auto values = arr.span<&event::value>();
+    values[0] = 10.0;
+    REQUIRE(arr[0].get<&event::value>() == 10.0);
+  }
+
+  SECTION("map() and reduce()") {
+    auto doubled = arr.map<&event::ts>([](long ts) { return ts * 2; });
+    REQUIRE(doubled[3] == 8);
+    double total = arr.reduce<&event::value>([](double a, double b) { return a + b; }, 0.0);
+    REQUIRE(total == 10.0);
+  }
+
+  SECTION("filter()") {
+    auto odd = arr.filter<&event::kind>([](int kind) { return kind == 1; });
+    REQUIRE(odd.size() == 2);
+    event second = odd[1];
+    REQUIRE(second.ts == 4);
+    REQUIRE(second.value == 4.0);
+  }
+
+  SECTION("slice()") {
+    auto middle = arr.slice(1, 3);
+    REQUIRE(middle.size() == 2);
+    REQUIRE(middle[0].get<&event::ts>() == 2);
+    REQUIRE(middle[1].get<&event::ts>() == 3);
+  }
+}
@@ -0,0 +1,81 @@
+#include "array.hpp"
+#include "static_array.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace stdlib;
+
+namespace {
+consteval static_array<int, 8> squares() {
+  static_array<int, 8> table;
+  for (int i = 0; i < 8; ++i) {
+    table.push(i * i);
+  }
+  return table;
+}
+
+consteval static_array<int, 8> odd_squares() {
+  // Transient allocations of array are allowed as long as they are freed.
+  array<int> arr;
+  for (int value : squares()) {
+    arr.push(value);
+  }
+  return static_array<int, 8>(arr.filter([](int x) { return x % 2 == 1; }));
+}
+
+constexpr auto table = squares();
+} // namespace
+
+TEST_CASE("Static array construction", "[static_array]") {
+  SECTION("consteval construction") {
+    static_assert(table.size() == 8);
+    static_assert(table[7] == 49);
+    static_assert(odd_squares() == static_array<int, 8> { 1, 9, 25, 49 });
+    REQUIRE(table[3] == 9);
+  }
+
+  SECTION("Initializer list constructor") {
+    static_array<int, 4> arr = { 1, 2, 3 };
+    REQUIRE(arr.size() == 3);
+    REQUIRE(arr.capacity() == 4);
+    REQUIRE_THROWS_AS((static_array<int, 2> { 1, 2, 3 }), std::length_error);
+  }
+}
+
+TEST_CASE("Static array modification", "[static_array]") {
+  static_array<int, 3> arr;
+
+  SECTION("push() and pop()") {
+    arr.push(1);
+    arr.push(2);
+    arr.push(3);
+    REQUIRE(arr.full());
+    REQUIRE_THROWS_AS(arr.push(4), std::length_error);
+    REQUIRE(arr.pop() == 3);
+    REQUIRE(arr.size() == 2);
+  }
+
+  SECTION("unshift() and shift()") {
+    arr.unshift(1);
+    arr.unshift(2);
+    REQUIRE(arr[0] == 2);
+    REQUIRE(arr.shift() == 2);
+    REQUIRE(arr.shift() == 1);
+    REQUIRE_THROWS_AS(arr.shift(), std::out_of_range);
+  }
+}
+
+TEST_CASE("Static array utility functions", "[static_array]") {
+  constexpr static_array<int, 5> arr = { 3, 1, 4, 1, 5 };
+
+  static_assert(arr.map([](int x) { return x * 2; })[4] == 10);
+  static_assert(arr.filter([](int x) { return x > 2; }).size() == 3);
+  static_assert(arr.reduce([](int acc, int x) { return acc + x; }, 0) == 14);
+  static_assert(arr.reduce([](double acc, int x) { return acc + x * 0.5; }, 0.0) == 7.0);
+  static_assert(arr.sort() == static_array<int, 5> { 1, 1, 3, 4, 5 });
+  static_assert(arr.reverse()[0] == 5);
+  static_assert(arr.slice(1, 3) == static_array<int, 5> { 1, 4 });
+  REQUIRE(arr.join(", ") == "3, 1, 4, 1, 5");
+  REQUIRE(arr.slice(2, 5).join() == "4,1,5");
+  static_array<std::string, 3> words = { "a", "b" };
+  REQUIRE(words.join() == array<std::string> { "a", "b" }.join());
+}
@@ -0,0 +1,116 @@
+#include "string_array.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+
+using namespace stdlib;
+
+TEST_CASE("String array", "[string_array]") {
+  string_array words = { "alpha", "", "beta", "gamma" };
+
+  SECTION("construction and access") {
+    REQUIRE(words.size() == 4);
+    REQUIRE(words.byte_size() == 14);
+    REQUIRE(words[0] == "alpha");
+    REQUIRE(words[1].empty());
+    REQUIRE(words.at(3) == "gamma");
+    REQUIRE_THROWS_AS(words[4], std::out_of_range);
+    REQUIRE_THROWS_AS(words[-1], std::out_of_range);
+  }
+
+  SECTION("push() and pop()") {
+    string_array arr;
+    for (int i = 0; i < 1000; ++i) {
+      arr.push(std::to_string(i));
+    }
+    REQUIRE(arr.size() == 1000);
+    REQUIRE(arr[999] == "999");
+    REQUIRE(arr.pop() == "999");
+    REQUIRE(arr.size() == 999);
+    REQUIRE_THROWS_AS(string_array().pop(), std::out_of_range);
+  }
+
+  SECTION("shift() and unshift()") {
+    REQUIRE(words.shift() == "alpha");
+    REQUIRE(words[0].empty());
+    words.unshift("ab");
+    REQUIRE(words.byte_capacity() == 14);
+    words.unshift("zeta");
+    REQUIRE(words == string_array { "zeta", "ab", "", "beta", "gamma" });
+    REQUIRE_THROWS_AS(string_array().shift(), std::out_of_range);
+  }
+
+  SECTION("push() reuses the bytes freed by shift()") {
+    string_array queue;
+    queue.reserve(4, 64);
+    for (int i = 0; i < 1000; ++i) {
+      queue.push("abcdefgh");
+      if (queue.size() > 3) queue.shift();
+    }
+    REQUIRE(queue.byte_capacity() == 64);
+    REQUIRE(queue == string_array { "abcdefgh", "abcdefgh", "abcdefgh" });
+  }
+
+  SECTION("push() and unshift() of the array's own strings") {
+    string_array own = { "alpha", "beta" };
+    own.push(own[0]);
+    own.unshift(own[2]);
+    own.push(own[2]);
+    REQUIRE(own == string_array { "alpha", "alpha", "beta", "alpha", "beta" });
+
+    string_array queue;
+    queue.reserve(8, 32);
+    for (std::string_view value : { "aaaaaaaa", "bbbbbbbb", "cccccccc", "dddddddd" }) {
+      queue.push(value);
+    }
+    queue.shift();
+    queue.shift();
+    queue.shift();
+    queue.push(queue[0]);
+    queue.unshift(queue[1]);
+    REQUIRE(queue == string_array { "dddddddd", "dddddddd", "dddddddd" });
+  }
+
+  SECTION("slice() and filter()") {
+    REQUIRE(words.slice(1, 4) == string_array { "", "beta", "gamma" });
+    auto sliced = words.slice(2, 4);
+    REQUIRE(sliced.byte_size() == 9);
+    REQUIRE(sliced.byte_capacity() == 9);
+    auto filtered = words.filter([](std::string_view w) { return w.size() > 4; });
+    REQUIRE(filtered == string_array { "alpha", "gamma" });
+    REQUIRE(filtered.byte_capacity() == 10);
+  }
+
+  SECTION("map(), reduce() and for_each()") {
+    REQUIRE(words.map([](std::string_view w) { return w.size(); }) == array<std::size_t> { 5, 0, 4, 5 });
+    REQUIRE(words.reduce([](std::size_t total, std::string_view w) { return total + w.size(); }, std::size_t { 0 }) == 14);
+    REQUIRE(words.reduce([](std::size_t total, std::string_view w) { return total + w.size(); }, 0) == 14);
+    REQUIRE(words.reduce([](std::string acc, std::string_view w) { return acc + std::string(w.substr(0, 1)); }, "") == "abg");
+    std::string indexed;
+    words.for_each([&](std::string_view w, std::size_t i) { indexed += std::to_string(i) + std::string(w); });
+    REQUIRE(indexed == "0alpha12beta3gamma");
+  }
+
+  SECTION("join() matches array<std::string>") {
+    REQUIRE(words.join() == words.to_array().join());
+    REQUIRE(words.join(" | ") == words.to_array().join(" | "));
+    REQUIRE(string_array().join().empty());
+    std::ostringstream os;
+    os << words;
+    REQUIRE(os.str() == "[ alpha, , beta, gamma ]");
+  }
+
+  SECTION("conversions, copies and moves") {
+    array<std::string> strings = { "x", "yy" };
+    string_array packed(strings);
+    REQUIRE(packed.to_array() == strings);
+    string_array copy = words;
+    REQUIRE(copy == words);
+    string_array moved = std::move(copy);
+    REQUIRE(moved == words);
+    REQUIRE(copy.empty());
+    copy.push("again");
+    REQUIRE(copy == string_array { "again" });
+    REQUIRE(std::ranges::equal(words, words.to_array()));
+  }
+}